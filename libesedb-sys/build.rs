@@ -18,7 +18,7 @@
  */
 
 use cc::Build;
-use patch_apply::{apply, Patch};
+use patch_apply::{apply, Line, Patch};
 use std::env;
 use std::fs;
 use std::io;
@@ -32,10 +32,22 @@ fn apply_changes<P: AsRef<Path>, S: AsRef<str>>(root: P, patch_text: S) -> io::R
     match Patch::from_multiple(patch_text.as_ref()) {
         Ok(patches) => {
             for patch in patches {
+                let new_file_path = root.join(&*patch.new.path);
+                // New files are diffed against /dev/null, their text is the added lines.
+                if patch.old.path == "/dev/null" {
+                    let new_file_text: String = patch.hunks.iter()
+                        .flat_map(|hunk| hunk.lines.iter())
+                        .filter_map(|line| match line {
+                            Line::Add(text) => Some(format!("{text}\n")),
+                            _ => None,
+                        })
+                        .collect();
+                    fs::write(&new_file_path, new_file_text)?;
+                    continue;
+                }
                 let old_file_path = root.join(&*patch.old.path);
                 let old_file_text = fs::read_to_string(&old_file_path)?;
                 fs::remove_file(&old_file_path)?;
-                let new_file_path = root.join(&*patch.new.path);
                 let new_file_text = apply(old_file_text, patch);
                 fs::write(&new_file_path, new_file_text)?;
             }
@@ -49,6 +61,7 @@ fn apply_changes<P: AsRef<Path>, S: AsRef<str>>(root: P, patch_text: S) -> io::R
 
 fn main() {
     println!("cargo::rerun-if-changed=build.rs");
+    println!("cargo::rerun-if-changed=patches");
     println!("cargo::rerun-if-env-changed=LIBESEDB_MAXIMUM_NUMBER_OF_LEAF_PAGES");
 
     // docs.rs will attempt to compile, to allow for build scripts that generate
@@ -91,14 +104,16 @@ fn main() {
     let src_dir = out_dir.join(format!("libesedb-{VERSION}"));
 
     // Apply our downstream patches.
-    for ent in WalkDir::new("patches") {
-        let ent = ent.unwrap();
-        if !ent.file_type().is_file() { continue; }
-        let name = ent.file_name().to_str().unwrap();
-        if !name.ends_with(".patch") { continue; }
-
-        println!("cargo::warning=Applying {:?}", ent.path());
-        let patch_file_text = fs::read_to_string(ent.path()).unwrap();
+    // Patches are positional (no fuzzy matching), so they are applied in the
+    //   order listed in `patches/series`, each one made against the tree with
+    //   all of the patches before it applied.
+    let series = fs::read_to_string("patches/series").unwrap();
+    for name in series.lines().map(str::trim) {
+        if name.is_empty() || name.starts_with('#') { continue; }
+
+        let path = Path::new("patches").join(name);
+        println!("cargo::warning=Applying {path:?}");
+        let patch_file_text = fs::read_to_string(&path).unwrap();
         apply_changes(&src_dir, patch_file_text).unwrap();
     }
 
@@ -185,7 +200,7 @@ fn main() {
                 @@ -227,1 +227,1 @@\n\
                 -#define HAVE_LIBINTL_H 1\n\
                 +#undef HAVE_LIBINTL_H\n\
-                @@ -347,1 +347,1 @@\n\
+                @@ -350,1 +350,1 @@\n\
                 -#define HAVE_POSIX_FADVISE 1\n\
                 +#undef HAVE_POSIX_FADVISE\n\
             ").unwrap();
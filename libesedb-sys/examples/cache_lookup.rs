@@ -0,0 +1,156 @@
+/*
+Benchmark of the page cache lookup (libfcache_cache_get_value_by_identifier),
+filled to the size of the libesedb page caches.
+
+The libfcache functions are not part of the public libesedb API,
+but are linked into the static library, so they are declared here.
+*/
+
+#![allow(non_camel_case_types)]
+
+use std::env;
+use std::ffi::c_int;
+use std::hint::black_box;
+use std::ptr::null_mut;
+use std::time::Instant;
+
+use libesedb_sys::*;
+
+type libfcache_cache_t = isize;
+type libfcache_cache_value_t = isize;
+
+extern "C" {
+    fn libfcache_cache_initialize(
+        cache: *mut *mut libfcache_cache_t,
+        maximum_cache_entries: c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+    fn libfcache_cache_free(
+        cache: *mut *mut libfcache_cache_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+    fn libfcache_cache_get_value_by_identifier(
+        cache: *mut libfcache_cache_t,
+        file_index: c_int,
+        offset: i64,
+        timestamp: i64,
+        cache_value: *mut *mut libfcache_cache_value_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+    fn libfcache_cache_set_value_by_identifier(
+        cache: *mut libfcache_cache_t,
+        file_index: c_int,
+        offset: i64,
+        timestamp: i64,
+        value: *mut isize,
+        value_free_function: Option<
+            unsafe extern "C" fn(*mut *mut isize, *mut *mut libesedb_error_t) -> c_int,
+        >,
+        flags: u8,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+}
+
+/// LIBESEDB_MAXIMUM_CACHE_ENTRIES_PAGES
+const CACHE_ENTRIES: i64 = 8 * 1024 - 3;
+const PAGE_SIZE: i64 = 8192;
+const TIMESTAMP: i64 = 1;
+
+/// Simple xorshift generator, so the lookup order is reproducible.
+fn next_random(state: &mut u64) -> u64 {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    *state
+}
+
+unsafe fn lookup(cache: *mut libfcache_cache_t, page: i64) -> c_int {
+    let mut error = null_mut();
+    let mut cache_value = null_mut();
+    let result = libfcache_cache_get_value_by_identifier(
+        cache,
+        0,
+        page * PAGE_SIZE,
+        TIMESTAMP,
+        &mut cache_value,
+        &mut error,
+    );
+    if result == -1 {
+        libesedb_error_free(&mut error);
+        panic!("unable to retrieve value from cache");
+    }
+    black_box(cache_value);
+    result
+}
+
+fn report(name: &str, lookups: usize, start: Instant) {
+    let elapsed = start.elapsed();
+    println!(
+        "{name:>12}: {lookups} lookups in {elapsed:?} ({:.1} ns/lookup)",
+        elapsed.as_nanos() as f64 / lookups as f64
+    );
+}
+
+fn main() {
+    let lookups = env::args()
+        .nth(1)
+        .and_then(|n| n.parse().ok())
+        .unwrap_or(1_000_000usize);
+
+    unsafe {
+        let mut error = null_mut();
+        let mut cache = null_mut();
+
+        if libfcache_cache_initialize(&mut cache, CACHE_ENTRIES as _, &mut error) != 1 {
+            libesedb_error_free(&mut error);
+            panic!("unable to create cache");
+        }
+        for page in 0..CACHE_ENTRIES {
+            if libfcache_cache_set_value_by_identifier(
+                cache,
+                0,
+                page * PAGE_SIZE,
+                TIMESTAMP,
+                (page + 1) as _,
+                None,
+                0,
+                &mut error,
+            ) != 1
+            {
+                libesedb_error_free(&mut error);
+                panic!("unable to set value in cache");
+            }
+        }
+        println!("Cache filled with {CACHE_ENTRIES} entries.");
+
+        // Most recently used entry, the best case for a list walk.
+        let start = Instant::now();
+        for _ in 0..lookups {
+            lookup(cache, CACHE_ENTRIES - 1);
+        }
+        report("front", lookups, start);
+
+        // Cycling through every entry in insertion order hits the least
+        // recently used entry every time, the worst case for a list walk.
+        let start = Instant::now();
+        for i in 0..lookups {
+            lookup(cache, i as i64 % CACHE_ENTRIES);
+        }
+        report("back", lookups, start);
+
+        let mut state = 0x2545f4914f6cdd1d;
+        let start = Instant::now();
+        for _ in 0..lookups {
+            lookup(cache, (next_random(&mut state) % CACHE_ENTRIES as u64) as _);
+        }
+        report("random", lookups, start);
+
+        let start = Instant::now();
+        for i in 0..lookups {
+            assert_eq!(lookup(cache, CACHE_ENTRIES + i as i64), 0);
+        }
+        report("miss", lookups, start);
+
+        libfcache_cache_free(&mut cache, null_mut());
+    }
+}
@@ -0,0 +1,196 @@
+/*
+Benchmark of the page checksum kernels (libesedb_checksum_calculate_little_endian_ecc32
+and libesedb_checksum_calculate_little_endian_xor32) against a port of the scalar
+implementation they replaced, on page-sized buffers.
+
+The checksum functions are not part of the public libesedb API,
+but are linked into the static library, so they are declared here.
+*/
+
+use std::env;
+use std::ffi::c_int;
+use std::hint::black_box;
+use std::ptr::null_mut;
+use std::time::Instant;
+
+use libesedb_sys::*;
+
+extern "C" {
+    fn libesedb_checksum_calculate_little_endian_ecc32(
+        ecc_checksum_value: *mut u32,
+        xor_checksum_value: *mut u32,
+        buffer: *const u8,
+        size: usize,
+        offset: usize,
+        initial_value: u32,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+    fn libesedb_checksum_calculate_little_endian_xor32(
+        checksum_value: *mut u32,
+        buffer: *const u8,
+        size: usize,
+        initial_value: u32,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+}
+
+const PAGE_SIZES: [usize; 2] = [4096, 8192];
+
+/// Simple xorshift generator, so the page contents are reproducible.
+fn next_random(state: &mut u64) -> u64 {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    *state
+}
+
+fn parity(value: u32) -> bool {
+    value.count_ones() % 2 == 1
+}
+
+/// The scalar ECC-32 and XOR-32, one 32-bit value at a time.
+fn scalar_ecc32(buffer: &[u8], offset: usize, initial_value: u32) -> (u32, u32) {
+    let mut ecc = 0u32;
+    let mut bitmask = 0xff800000u32;
+    let mut vertical = [0u32; 4];
+    let mut xor32 = 0u32;
+    let mut alignment = offset % 16;
+
+    for value in buffer[offset..].chunks_exact(4) {
+        let value = u32::from_le_bytes(value.try_into().unwrap());
+        vertical[alignment / 4] ^= value;
+        xor32 ^= value;
+        alignment += 4;
+
+        if alignment == 16 {
+            if parity(xor32) {
+                ecc ^= bitmask;
+            }
+            bitmask = bitmask.wrapping_sub(0x007fff80);
+            alignment = 0;
+            xor32 = 0;
+        }
+    }
+    if parity(xor32) {
+        ecc ^= bitmask;
+    }
+    for (first, second, bit) in [(0, 1, 0x00400000), (0, 2, 0x00200000), (1, 3, 0x20), (2, 3, 0x40)] {
+        if parity(vertical[first] ^ vertical[second]) {
+            ecc ^= bit;
+        }
+    }
+    let xor32 = vertical.iter().fold(0, |xor32, value| xor32 ^ value);
+
+    let mut bitmask = 0xffff0000u32;
+    let mut final_bitmask = 0;
+    for bit in 0..32 {
+        if xor32 & (1 << bit) != 0 {
+            final_bitmask ^= bitmask;
+        }
+        bitmask = bitmask.wrapping_sub(0x0000ffff);
+    }
+    if buffer.len() < 8192 {
+        ecc &= !((buffer.len() as u32) << 19);
+    }
+    ecc ^= (ecc ^ final_bitmask) & 0x001f001f;
+
+    (ecc, initial_value ^ xor32)
+}
+
+fn scalar_xor32(buffer: &[u8], initial_value: u32) -> u32 {
+    buffer
+        .chunks_exact(4)
+        .fold(initial_value, |xor32, value| xor32 ^ u32::from_le_bytes(value.try_into().unwrap()))
+}
+
+unsafe fn ecc32(buffer: &[u8], offset: usize, initial_value: u32) -> (u32, u32) {
+    let mut error = null_mut();
+    let mut ecc = 0;
+    let mut xor32 = 0;
+    if libesedb_checksum_calculate_little_endian_ecc32(
+        &mut ecc,
+        &mut xor32,
+        buffer.as_ptr(),
+        buffer.len(),
+        offset,
+        initial_value,
+        &mut error,
+    ) != 1
+    {
+        libesedb_error_free(&mut error);
+        panic!("unable to calculate ECC-32 and XOR-32 checksum");
+    }
+    (ecc, xor32)
+}
+
+unsafe fn xor32(buffer: &[u8], initial_value: u32) -> u32 {
+    let mut error = null_mut();
+    let mut xor32 = 0;
+    if libesedb_checksum_calculate_little_endian_xor32(
+        &mut xor32,
+        buffer.as_ptr(),
+        buffer.len(),
+        initial_value,
+        &mut error,
+    ) != 1
+    {
+        libesedb_error_free(&mut error);
+        panic!("unable to calculate XOR-32 checksum");
+    }
+    xor32
+}
+
+fn report(name: &str, page_size: usize, pages: usize, start: Instant) {
+    let elapsed = start.elapsed();
+    println!(
+        "{name:>12} {page_size:>5}: {pages} pages in {elapsed:?} ({:.1} ns/page, {:.2} GiB/s)",
+        elapsed.as_nanos() as f64 / pages as f64,
+        (page_size * pages) as f64 / elapsed.as_secs_f64() / (1u64 << 30) as f64
+    );
+}
+
+fn main() {
+    let pages = env::args()
+        .nth(1)
+        .and_then(|n| n.parse().ok())
+        .unwrap_or(100_000usize);
+
+    let mut state = 0x2545f4914f6cdd1d;
+
+    for page_size in PAGE_SIZES {
+        let page: Vec<u8> = (0..page_size).map(|_| next_random(&mut state) as u8).collect();
+
+        // The kernels must be bit-identical to the scalar implementation,
+        // the page number is the initial value of the page XOR-32.
+        unsafe {
+            for page_number in 0..64 {
+                assert_eq!(ecc32(&page, 8, page_number), scalar_ecc32(&page, 8, page_number));
+                assert_eq!(xor32(&page[4..], page_number), scalar_xor32(&page[4..], page_number));
+            }
+        }
+
+        let start = Instant::now();
+        for page_number in 0..pages {
+            black_box(scalar_ecc32(black_box(&page), 8, page_number as u32));
+        }
+        report("scalar ecc32", page_size, pages, start);
+
+        let start = Instant::now();
+        for page_number in 0..pages {
+            black_box(unsafe { ecc32(black_box(&page), 8, page_number as u32) });
+        }
+        report("ecc32", page_size, pages, start);
+
+        let start = Instant::now();
+        for page_number in 0..pages {
+            black_box(scalar_xor32(black_box(&page[4..]), page_number as u32));
+        }
+        report("scalar xor32", page_size, pages, start);
+
+        let start = Instant::now();
+        for page_number in 0..pages {
+            black_box(unsafe { xor32(black_box(&page[4..]), page_number as u32) });
+        }
+        report("xor32", page_size, pages, start);
+    }
+}
@@ -0,0 +1,276 @@
+/*
+Benchmark of the 7-bit compression decoder (libesedb_compression_7bit_decompress)
+against a port of the byte at a time implementation it replaced,
+and of the LZXPRESS decoder (libesedb_compression_lzxpress_decompress).
+
+The column data is read from the file given as the first argument, such as the
+text of a long value exported with esedbexport, otherwise this crate's README is used.
+Only the 7-bit ASCII characters of the data are compressed, as ESE does,
+LZXPRESS compresses at most 65535 bytes of the data as UTF-16, as large text columns are.
+
+The compression functions are not part of the public libesedb API,
+but are linked into the static library, so they are declared here.
+*/
+
+use std::collections::HashMap;
+use std::env;
+use std::ffi::c_int;
+use std::fs;
+use std::hint::black_box;
+use std::ptr::null_mut;
+use std::time::Instant;
+
+use libesedb_sys::*;
+
+extern "C" {
+    fn libesedb_compression_7bit_decompress(
+        compressed_data: *const u8,
+        compressed_data_size: usize,
+        uncompressed_data: *mut u8,
+        uncompressed_data_size: usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+    fn libesedb_compression_lzxpress_decompress(
+        compressed_data: *const u8,
+        compressed_data_size: usize,
+        uncompressed_data: *mut u8,
+        uncompressed_data_size: usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+}
+
+/// Leading byte of 7-bit compressed ASCII data.
+const COMPRESSION_7BIT_ASCII: u8 = 0x10;
+
+/// Packs the 7-bit values least significant bit first, after the leading byte.
+fn compress_7bit(data: &[u8]) -> Vec<u8> {
+    let mut compressed = vec![COMPRESSION_7BIT_ASCII];
+    let mut value = 0u32;
+    let mut bits = 0;
+
+    for byte in data {
+        value |= ((byte & 0x7f) as u32) << bits;
+        bits += 7;
+
+        while bits >= 8 {
+            compressed.push(value as u8);
+            value >>= 8;
+            bits -= 8;
+        }
+    }
+    if bits > 0 {
+        compressed.push(value as u8);
+    }
+    compressed
+}
+
+/// Leading byte of LZXPRESS compressed data.
+const COMPRESSION_LZXPRESS: u8 = 0x18;
+
+enum Token {
+    Literal(u8),
+    Match { distance: usize, length: usize },
+}
+
+/// Greedy LZXPRESS compression, matching the last occurrence of every 3 bytes.
+fn compress_lzxpress(data: &[u8]) -> Vec<u8> {
+    let mut last = HashMap::new();
+    let mut tokens = Vec::new();
+    let mut index = 0;
+
+    while index < data.len() {
+        let mut length = 0;
+        let previous = data
+            .get(index..index + 3)
+            .and_then(|key| last.insert(key, index));
+        if let Some(previous) = previous.filter(|previous| index - previous <= 8192) {
+            while index + length < data.len()
+                && length < 32771
+                && data[index + length] == data[previous + length]
+            {
+                length += 1;
+            }
+        }
+        if length >= 3 {
+            tokens.push(Token::Match {
+                distance: index - previous.unwrap(),
+                length,
+            });
+            index += length;
+        } else {
+            tokens.push(Token::Literal(data[index]));
+            index += 1;
+        }
+    }
+    let mut compressed = vec![COMPRESSION_LZXPRESS];
+    compressed.extend_from_slice(&(data.len() as u16).to_le_bytes());
+
+    // The extended sizes of 2 consecutive matches share a byte, one nibble each.
+    let mut shared = None;
+    for group in tokens.chunks(32) {
+        let mut flags = 0u32;
+        for (bit, token) in group.iter().enumerate() {
+            if let Token::Match { .. } = token {
+                flags |= 1 << (31 - bit);
+            }
+        }
+        if group.len() < 32 {
+            flags |= u32::MAX >> group.len();
+        }
+        compressed.extend_from_slice(&flags.to_le_bytes());
+
+        for token in group {
+            let (distance, length) = match *token {
+                Token::Literal(byte) => {
+                    compressed.push(byte);
+                    continue;
+                }
+                Token::Match { distance, length } => (distance, length),
+            };
+            let size = length - 3;
+            let tuple = ((distance - 1) << 3) | size.min(7);
+            compressed.extend_from_slice(&(tuple as u16).to_le_bytes());
+            if size >= 7 {
+                let nibble = (size - 7).min(15) as u8;
+                match shared.take() {
+                    None => {
+                        shared = Some(compressed.len());
+                        compressed.push(nibble);
+                    }
+                    Some(shared) => compressed[shared] |= nibble << 4,
+                }
+                if size >= 22 {
+                    compressed.push((size - 22).min(255) as u8);
+                    if size >= 277 {
+                        compressed.extend_from_slice(&(size as u16).to_le_bytes());
+                    }
+                }
+            }
+        }
+    }
+    compressed
+}
+
+/// The byte at a time decoder, through a 16-bit shift register.
+fn scalar_decompress(compressed: &[u8], uncompressed: &mut [u8]) -> usize {
+    let mut value = 0u16;
+    let mut bit_index = 0;
+    let mut index = 0;
+
+    for &byte in &compressed[1..] {
+        value |= (byte as u16) << bit_index;
+        uncompressed[index] = (value & 0x7f) as u8;
+        index += 1;
+        value >>= 7;
+        bit_index += 1;
+
+        if bit_index == 7 {
+            uncompressed[index] = (value & 0x7f) as u8;
+            index += 1;
+            value >>= 7;
+            bit_index = 0;
+        }
+    }
+    assert_eq!(value, 0, "unsupported remainder");
+    index
+}
+
+unsafe fn decompress(compressed: &[u8], uncompressed: &mut [u8]) {
+    let mut error = null_mut();
+    if libesedb_compression_7bit_decompress(
+        compressed.as_ptr(),
+        compressed.len(),
+        uncompressed.as_mut_ptr(),
+        uncompressed.len(),
+        &mut error,
+    ) != 1
+    {
+        libesedb_error_free(&mut error);
+        panic!("unable to decompress 7-bit compressed data");
+    }
+}
+
+unsafe fn decompress_lzxpress(compressed: &[u8], uncompressed: &mut [u8]) {
+    let mut error = null_mut();
+    if libesedb_compression_lzxpress_decompress(
+        compressed.as_ptr(),
+        compressed.len(),
+        uncompressed.as_mut_ptr(),
+        uncompressed.len(),
+        &mut error,
+    ) != 1
+    {
+        libesedb_error_free(&mut error);
+        panic!("unable to decompress LZXPRESS compressed data");
+    }
+}
+
+fn report(name: &str, size: usize, iterations: usize, start: Instant) {
+    let elapsed = start.elapsed();
+    println!(
+        "{name:>6}: {iterations} x {size} bytes in {elapsed:?} ({:.2} GiB/s)",
+        (size * iterations) as f64 / elapsed.as_secs_f64() / (1u64 << 30) as f64
+    );
+}
+
+fn main() {
+    let data = match env::args().nth(1) {
+        Some(path) => fs::read(&path).expect("unable to read column data"),
+        None => include_bytes!("../README.md").to_vec(),
+    };
+    let data: Vec<u8> = data.into_iter().map(|byte| byte & 0x7f).collect();
+    let compressed = compress_7bit(&data);
+    let size = ((compressed.len() - 1) * 8) / 7;
+    let mut expected = vec![0u8; size];
+    let mut uncompressed = vec![0u8; size];
+
+    // The decoder must be bit-identical to the scalar implementation,
+    // also for every length that ends part way through a 7 byte group.
+    for length in 0..data.len().min(256) {
+        let compressed = compress_7bit(&data[..length]);
+        let size = ((compressed.len() - 1) * 8) / 7;
+        let mut expected = vec![0u8; size];
+        let mut uncompressed = vec![0u8; size];
+        scalar_decompress(&compressed, &mut expected);
+        unsafe { decompress(&compressed, &mut uncompressed) };
+        assert_eq!(uncompressed, expected);
+    }
+    assert_eq!(scalar_decompress(&compressed, &mut expected), size);
+    unsafe { decompress(&compressed, &mut uncompressed) };
+    assert_eq!(uncompressed, expected);
+    assert_eq!(&uncompressed[..data.len()], &data[..]);
+
+    let iterations = env::args()
+        .nth(2)
+        .and_then(|n| n.parse().ok())
+        .unwrap_or((1usize << 30) / size.max(1));
+
+    let start = Instant::now();
+    for _ in 0..iterations {
+        scalar_decompress(black_box(&compressed), black_box(&mut expected));
+    }
+    report("scalar", size, iterations, start);
+
+    let start = Instant::now();
+    for _ in 0..iterations {
+        unsafe { decompress(black_box(&compressed), black_box(&mut uncompressed)) };
+    }
+    report("7bit", size, iterations, start);
+
+    let text: Vec<u8> = data
+        .iter()
+        .flat_map(|byte| [*byte, 0])
+        .take(65535 & !1)
+        .collect();
+    let compressed = compress_lzxpress(&text);
+    let mut uncompressed = vec![0u8; text.len()];
+    unsafe { decompress_lzxpress(&compressed, &mut uncompressed) };
+    assert_eq!(uncompressed, text);
+
+    let iterations = (1usize << 30) / text.len().max(1);
+    let start = Instant::now();
+    for _ in 0..iterations {
+        unsafe { decompress_lzxpress(black_box(&compressed), black_box(&mut uncompressed)) };
+    }
+    report("lzxpress", text.len(), iterations, start);
+}
@@ -0,0 +1,129 @@
+/*
+Benchmark of the UTF-16 stream to UTF-8 string conversion
+(libuna_utf8_string_with_index_copy_from_utf16_stream), that all text values are read with,
+against the conversion of the standard library.
+
+The text is read from the file given as the first argument, otherwise this crate's README is used.
+It is converted as a whole, and in pieces of 32 characters as short text columns are,
+once as is and once with every 16th character replaced by a non-ASCII one.
+
+The libuna functions are not part of the public libesedb API,
+but are linked into the static library, so they are declared here.
+*/
+
+use std::char::decode_utf16;
+use std::env;
+use std::ffi::c_int;
+use std::fs;
+use std::hint::black_box;
+use std::ptr::null_mut;
+use std::time::Instant;
+
+use libesedb_sys::*;
+
+extern "C" {
+    fn libuna_utf8_string_with_index_copy_from_utf16_stream(
+        utf8_string: *mut u8,
+        utf8_string_size: usize,
+        utf8_string_index: *mut usize,
+        utf16_stream: *const u8,
+        utf16_stream_size: usize,
+        byte_order: c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> c_int;
+}
+
+/// Byte order of a little-endian UTF-16 stream.
+const LIBUNA_ENDIAN_LITTLE: c_int = b'l' as c_int;
+
+/// Converts the UTF-16 stream, returning the size of the UTF-8 string including the end-of-string character.
+unsafe fn convert(utf16_stream: &[u8], utf8_string: &mut [u8]) -> usize {
+    let mut error = null_mut();
+    let mut utf8_string_index = 0;
+    if libuna_utf8_string_with_index_copy_from_utf16_stream(
+        utf8_string.as_mut_ptr(),
+        utf8_string.len(),
+        &mut utf8_string_index,
+        utf16_stream.as_ptr(),
+        utf16_stream.len(),
+        LIBUNA_ENDIAN_LITTLE,
+        &mut error,
+    ) != 1
+    {
+        libesedb_error_free(&mut error);
+        panic!("unable to convert UTF-16 stream");
+    }
+    utf8_string_index
+}
+
+fn convert_std(utf16_stream: &[u8], utf8_string: &mut String) {
+    let units = utf16_stream
+        .chunks_exact(2)
+        .map(|unit| u16::from_le_bytes([unit[0], unit[1]]));
+    utf8_string.clear();
+    utf8_string.extend(decode_utf16(units).map(|c| c.unwrap()));
+}
+
+fn run(name: &str, text: &str, piece_size: usize) {
+    let characters: Vec<char> = text.chars().collect();
+    let pieces: Vec<Vec<u8>> = characters
+        .chunks(piece_size)
+        .map(|piece| {
+            let piece: String = piece.iter().collect();
+            piece.encode_utf16().flat_map(u16::to_le_bytes).collect()
+        })
+        .collect();
+    let size: usize = pieces.iter().map(Vec::len).sum();
+    let mut utf8_string = vec![0u8; (piece_size * 4) + 1];
+    let mut expected = String::new();
+
+    for piece in &pieces {
+        let size = unsafe { convert(piece, &mut utf8_string) };
+        convert_std(piece, &mut expected);
+        assert_eq!(&utf8_string[..size - 1], expected.as_bytes());
+        assert_eq!(utf8_string[size - 1], 0);
+    }
+    let iterations = ((1usize << 28) / size.max(1)).max(1);
+
+    let start = Instant::now();
+    for _ in 0..iterations {
+        for piece in &pieces {
+            convert_std(black_box(piece), black_box(&mut expected));
+        }
+    }
+    let std_elapsed = start.elapsed();
+
+    let start = Instant::now();
+    for _ in 0..iterations {
+        for piece in &pieces {
+            unsafe { convert(black_box(piece), black_box(&mut utf8_string)) };
+        }
+    }
+    let elapsed = start.elapsed();
+
+    let size = (size * iterations) as f64 / (1u64 << 30) as f64;
+    println!(
+        "{name:>12}, {piece_size:>6} characters: std {:.2} GiB/s, libuna {:.2} GiB/s",
+        size / std_elapsed.as_secs_f64(),
+        size / elapsed.as_secs_f64()
+    );
+}
+
+fn main() {
+    let text = match env::args().nth(1) {
+        Some(path) => fs::read_to_string(&path).expect("unable to read text"),
+        None => include_str!("../README.md").to_string(),
+    };
+    // An end-of-string character ends the conversion.
+    let text = text.replace('\0', " ");
+    let mixed: String = text
+        .chars()
+        .enumerate()
+        .map(|(index, c)| if index % 16 == 15 { 'é' } else { c })
+        .collect();
+
+    for (name, text) in [("text", &text), ("mixed", &mixed)] {
+        run(name, text, 32);
+        run(name, text, text.chars().count());
+    }
+}
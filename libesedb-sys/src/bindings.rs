@@ -3095,9 +3095,12 @@ extern "C" {
 pub type libesedb_column_t = isize;
 pub type libesedb_file_t = isize;
 pub type libesedb_index_t = isize;
+pub type libesedb_index_cursor_t = isize;
 pub type libesedb_long_value_t = isize;
 pub type libesedb_multi_value_t = isize;
+pub type libesedb_page_verifier_t = isize;
 pub type libesedb_record_t = isize;
+pub type libesedb_record_cursor_t = isize;
 pub type libesedb_table_t = isize;
 pub const LIBESEDB_CODEPAGES_LIBESEDB_CODEPAGE_ASCII: LIBESEDB_CODEPAGES = 20127;
 pub const LIBESEDB_CODEPAGES_LIBESEDB_CODEPAGE_ISO_8859_1: LIBESEDB_CODEPAGES = 28591;
@@ -3178,6 +3181,29 @@ pub const LIBESEDB_VALUE_FLAGS_LIBESEDB_VALUE_FLAG_LONG_VALUE: LIBESEDB_VALUE_FL
 pub const LIBESEDB_VALUE_FLAGS_LIBESEDB_VALUE_FLAG_MULTI_VALUE: LIBESEDB_VALUE_FLAGS = 8;
 #[doc = " The value flags"]
 pub type LIBESEDB_VALUE_FLAGS = ::std::os::raw::c_int;
+pub const LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_CHECKSUM_MISMATCH:
+    LIBESEDB_PAGE_VERIFICATION_FLAGS = 1;
+pub const LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_INVALID_HEADER:
+    LIBESEDB_PAGE_VERIFICATION_FLAGS = 2;
+pub const LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_PAGE_NUMBER_MISMATCH:
+    LIBESEDB_PAGE_VERIFICATION_FLAGS = 4;
+pub const LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_TRUNCATED:
+    LIBESEDB_PAGE_VERIFICATION_FLAGS = 8;
+#[doc = " The page verification flags"]
+pub type LIBESEDB_PAGE_VERIFICATION_FLAGS = ::std::os::raw::c_int;
+pub const LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_EQUAL: LIBESEDB_INDEX_MATCH_MODES = 0;
+pub const LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_GREATER_EQUAL:
+    LIBESEDB_INDEX_MATCH_MODES = 1;
+pub const LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_PREFIX: LIBESEDB_INDEX_MATCH_MODES =
+    2;
+#[doc = " The index match modes"]
+pub type LIBESEDB_INDEX_MATCH_MODES = ::std::os::raw::c_int;
+pub const LIBESEDB_INDEX_CURSOR_FLAGS_LIBESEDB_INDEX_CURSOR_FLAG_REVERSE: LIBESEDB_INDEX_CURSOR_FLAGS =
+    1;
+pub const LIBESEDB_INDEX_CURSOR_FLAGS_LIBESEDB_INDEX_CURSOR_FLAG_INCLUDE_UPPER_KEY:
+    LIBESEDB_INDEX_CURSOR_FLAGS = 2;
+#[doc = " The index cursor flags"]
+pub type LIBESEDB_INDEX_CURSOR_FLAGS = ::std::os::raw::c_int;
 #[doc = " External error type definition hides internal structure"]
 pub type libesedb_error_t = isize;
 pub const LIBESEDB_ERROR_DOMAINS_LIBESEDB_ERROR_DOMAIN_ARGUMENTS: LIBESEDB_ERROR_DOMAINS = 97;
@@ -3896,6 +3922,16 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Sets the cache limits\n The limits are the maximum sizes, in bytes, of the page data in the caches\n The pages cache size applies to the pages caches of the file and of the tables,\n the long values pages cache size to the long values pages caches of the tables\n and the long value data cache size to the data segments cache of each long value\n A size of 0 selects the default number of cache entries\n The limits apply to the caches that are created after this, so preferably set them before the file is opened\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_file_set_cache_limits(
+        file: *mut libesedb_file_t,
+        pages_cache_size: size64_t,
+        long_values_pages_cache_size: size64_t,
+        long_value_data_cache_size: size64_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Opens a file\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_file_open(
@@ -3905,6 +3941,15 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Opens a file using a read-only memory mapping\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_file_open_mmap(
+        file: *mut libesedb_file_t,
+        filename: *const ::std::os::raw::c_char,
+        access_flags: ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Closes a file\n Returns 0 if successful or -1 on error"]
     pub fn libesedb_file_close(
@@ -3946,6 +3991,23 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves the number of pages\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_file_get_number_of_pages(
+        file: *mut libesedb_file_t,
+        number_of_pages: *mut u32,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Verifies the checksums and page headers of all the pages\n The file is read sequentially in large chunks, the pages are verified by number_of_threads worker threads\n If number_of_threads is 0 the pages are verified on the calling thread\n The bad pages are returned in a page verifier that needs to be freed with libesedb_page_verifier_free\n Returns 1 if all pages are valid, 0 if there are bad pages or -1 on error"]
+    pub fn libesedb_file_verify_pages(
+        file: *mut libesedb_file_t,
+        number_of_threads: ::std::os::raw::c_int,
+        page_verifier: *mut *mut libesedb_page_verifier_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the number of tables\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_file_get_number_of_tables(
@@ -3983,6 +4045,31 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Frees a page verifier\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_page_verifier_free(
+        page_verifier: *mut *mut libesedb_page_verifier_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the number of bad pages\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_page_verifier_get_number_of_bad_pages(
+        page_verifier: *mut libesedb_page_verifier_t,
+        number_of_bad_pages: *mut ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves a specific bad page\n The bad pages are sorted by page number, flags contains LIBESEDB_PAGE_VERIFICATION_FLAGS\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_page_verifier_get_bad_page(
+        page_verifier: *mut libesedb_page_verifier_t,
+        bad_page_index: ::std::os::raw::c_int,
+        page_number: *mut u32,
+        flags: *mut u32,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Frees a table\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_table_free(
@@ -3990,6 +4077,14 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Clones a table\n The clone shares the table definition with the source table, but has its own page caches\n and page trees, so the source and the clone can be used from different threads\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_table_clone(
+        destination_table: *mut *mut libesedb_table_t,
+        source_table: *mut libesedb_table_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the table identifier or Father Data Page (FDP) object identifier\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_table_get_identifier(
@@ -4110,6 +4205,23 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves the number of leaf pages in the table\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_table_get_number_of_leaf_pages(
+        table: *mut libesedb_table_t,
+        number_of_leaf_pages: *mut ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the page number of a specific leaf page in the table\n The leaf pages are numbered in the order of the records they contain\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_table_get_leaf_page_number(
+        table: *mut libesedb_table_t,
+        leaf_page_index: ::std::os::raw::c_int,
+        leaf_page_number: *mut u32,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the record for the specific entry\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_table_get_record(
@@ -4119,6 +4231,24 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves a cursor over the records of the table\n The cursor reads the records in order, which is faster than libesedb_table_get_record\n when reading all the records of the table\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_table_get_record_cursor(
+        table: *mut libesedb_table_t,
+        record_cursor: *mut *mut libesedb_record_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves a cursor over the records in a range of leaf pages of the table\n The cursor reads the records from the first leaf page up to and including the last leaf page,\n which are retrieved with libesedb_table_get_leaf_page_number\n A table can be split into ranges that are read by cursors of different clones of the table\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_table_get_record_cursor_by_leaf_page_range(
+        table: *mut libesedb_table_t,
+        first_leaf_page_number: u32,
+        last_leaf_page_number: u32,
+        record_cursor: *mut *mut libesedb_record_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Frees a column\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_column_free(
@@ -4242,6 +4372,94 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Seeks the index values by key\n The key is a normalized index key, as stored in the index, that is compared byte by byte\n with the keys of the index values\n The index cursor reads the records of the index values that match the key in index order,\n match_mode contains a LIBESEDB_INDEX_MATCH_MODES value:\n LIBESEDB_INDEX_MATCH_MODE_EQUAL reads the index values with a key equal to the key,\n LIBESEDB_INDEX_MATCH_MODE_PREFIX the index values with a key that starts with the key and\n LIBESEDB_INDEX_MATCH_MODE_GREATER_EQUAL all the index values from the key onwards\n The index should not be freed before the index cursor\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_index_seek(
+        index: *mut libesedb_index_t,
+        key: *const u8,
+        key_size: usize,
+        match_mode: ::std::os::raw::c_int,
+        index_cursor: *mut *mut libesedb_index_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves an index cursor over a range of keys\n The keys are normalized index keys, as stored in the index, that are compared byte by byte\n with the keys of the index values\n The index cursor reads the records of the index values with a key that is not less than\n the lower key and less than the upper key, in index order or in reverse index order\n if flags contains LIBESEDB_INDEX_CURSOR_FLAG_REVERSE\n If flags contains LIBESEDB_INDEX_CURSOR_FLAG_INCLUDE_UPPER_KEY the index values with a key\n that starts with the upper key are also read\n The lower key is NULL if the range has no lower bound and the upper key is NULL\n if the range has no upper bound\n The index should not be freed before the index cursor\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_index_get_cursor_by_key_range(
+        index: *mut libesedb_index_t,
+        lower_key: *const u8,
+        lower_key_size: usize,
+        upper_key: *const u8,
+        upper_key_size: usize,
+        flags: u8,
+        index_cursor: *mut *mut libesedb_index_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Frees an index cursor\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_index_cursor_free(
+        index_cursor: *mut *mut libesedb_index_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the record of the next index value\n Returns 1 if successful, 0 if there are no more records or -1 on error"]
+    pub fn libesedb_index_cursor_next(
+        index_cursor: *mut libesedb_index_cursor_t,
+        record: *mut *mut libesedb_record_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the key of the next index value\n The key references data of the cursor and remains valid until the cursor is advanced or freed\n Returns 1 if successful, 0 if there are no more index values or -1 on error"]
+    pub fn libesedb_index_cursor_next_key(
+        index_cursor: *mut libesedb_index_cursor_t,
+        key: *mut *const u8,
+        key_size: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the record of the index value of which the key was last retrieved\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_index_cursor_get_record(
+        index_cursor: *mut libesedb_index_cursor_t,
+        record: *mut *mut libesedb_record_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Frees a record cursor\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_record_cursor_free(
+        record_cursor: *mut *mut libesedb_record_cursor_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Sets the column projection\n The records read by the cursor after this only contain the values of the columns\n in the projection, in the order of the column entries, the other columns are not read\n A column projection without column entries (NULL) reads all columns again\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_record_cursor_set_column_projection(
+        record_cursor: *mut libesedb_record_cursor_t,
+        column_entries: *const ::std::os::raw::c_int,
+        number_of_column_entries: ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Sets the number of records that are read ahead to prefetch their long values\n The leaf pages of the long values page tree that contain the long values of the records\n are read in ascending page order, adjacent pages with a single read, before the records are returned\n A number of records of 0 disables the prefetch, which is the default\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_record_cursor_set_long_values_prefetch(
+        record_cursor: *mut libesedb_record_cursor_t,
+        number_of_records: ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the next record\n Returns 1 if successful, 0 if there are no more records or -1 on error"]
+    pub fn libesedb_record_cursor_next(
+        record_cursor: *mut libesedb_record_cursor_t,
+        record: *mut *mut libesedb_record_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Frees a record\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_record_free(
@@ -4432,6 +4650,26 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves the maximum size of an UTF-8 encoded string of a specific entry\n The size is determined without decompressing or converting the value,\n so it can be used to allocate the string for libesedb_record_get_value_utf8_string_with_index\n The returned size includes the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
+    pub fn libesedb_record_get_value_utf8_string_maximum_size(
+        record: *mut libesedb_record_t,
+        value_entry: ::std::os::raw::c_int,
+        utf8_string_size: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the UTF-8 encoded string of a specific entry\n The function uses the codepage in the column definition if necessary\n A compressed value is decompressed once, into a buffer that is reused by the values of the record\n The string is copied from the UTF-8 string index, which is advanced past the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
+    pub fn libesedb_record_get_value_utf8_string_with_index(
+        record: *mut libesedb_record_t,
+        value_entry: ::std::os::raw::c_int,
+        utf8_string: *mut u8,
+        utf8_string_size: usize,
+        utf8_string_index: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the size of an UTF-16 encoded string a specific entry\n The returned size includes the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
     pub fn libesedb_record_get_value_utf16_string_size(
@@ -4539,6 +4777,16 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Reads data at a specific offset\n Only the data segments that contain the requested data are read\n Returns the number of bytes read, 0 at or beyond the end of the data or -1 on error"]
+    pub fn libesedb_long_value_read_buffer_at_offset(
+        long_value: *mut libesedb_long_value_t,
+        buffer: *mut u8,
+        buffer_size: usize,
+        offset: off64_t,
+        error: *mut *mut libesedb_error_t,
+    ) -> isize;
+}
 extern "C" {
     #[doc = " Retrieve the number of data segments\n Returns 1 if successful or -1 on error"]
     pub fn libesedb_long_value_get_number_of_data_segments(
@@ -4566,6 +4814,24 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves a view of the data segment without copying its data\n The data references the page that contains the data segment, which is pinned in memory\n The data remains valid until the view is released or the long value is freed\n Returns 1 if successful or -1 on error"]
+    pub fn libesedb_long_value_get_data_segment_view(
+        long_value: *mut libesedb_long_value_t,
+        data_segment_index: ::std::os::raw::c_int,
+        data: *mut *const u8,
+        data_size: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Releases the view of the data segment\n Returns 1 if successful, 0 if the data segment has no view or -1 on error"]
+    pub fn libesedb_long_value_release_data_segment_view(
+        long_value: *mut libesedb_long_value_t,
+        data_segment_index: ::std::os::raw::c_int,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the size of the data as an UTF-8 encoded string\n The returned size includes the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
     pub fn libesedb_long_value_get_utf8_string_size(
@@ -4583,6 +4849,24 @@ extern "C" {
         error: *mut *mut libesedb_error_t,
     ) -> ::std::os::raw::c_int;
 }
+extern "C" {
+    #[doc = " Retrieves the maximum size of the data as an UTF-8 encoded string\n The size is determined without decompressing or converting the data,\n so it can be used to allocate the string for libesedb_long_value_get_utf8_string_with_index\n The returned size includes the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
+    pub fn libesedb_long_value_get_utf8_string_maximum_size(
+        long_value: *mut libesedb_long_value_t,
+        utf8_string_size: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
+extern "C" {
+    #[doc = " Retrieves the data as an UTF-8 encoded string\n The function uses the codepage in the column definition if necessary\n Compressed data is decompressed once, into a buffer that is reused by subsequent calls\n The string is copied from the UTF-8 string index, which is advanced past the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
+    pub fn libesedb_long_value_get_utf8_string_with_index(
+        long_value: *mut libesedb_long_value_t,
+        utf8_string: *mut u8,
+        utf8_string_size: usize,
+        utf8_string_index: *mut usize,
+        error: *mut *mut libesedb_error_t,
+    ) -> ::std::os::raw::c_int;
+}
 extern "C" {
     #[doc = " Retrieves the size of the data as an UTF-16 encoded string\n The returned size includes the end of string character\n Returns 1 if successful, 0 if value is NULL or -1 on error"]
     pub fn libesedb_long_value_get_utf16_string_size(
@@ -24,6 +24,8 @@
 //!
 //! ## Downstream Patches
 //!
+//! Patches live in `patches/` and are applied by `build.rs` in the order listed in `patches/series`.
+//!
 //! ### Bugfix: Multi-Value Binary Data
 //!
 //! <https://github.com/libyal/libesedb/pull/69>
@@ -49,6 +51,213 @@
 //!
 //! If you do set a leaf-page maximum, when it is exceeded the error message actually reports back that limit so anyone downstream can provide useful debugging information.
 //!
+//! ### Perf: Hash-Indexed Page Cache
+//!
+//! `libfcache_cache_get_value_by_identifier` used to walk the whole LRU list to find a cached page, which costs thousands of pointer chases once a page cache (8189 entries) fills up.
+//! The cache now keeps a hash table from (file index, offset) to cache entry, and moves the hit to the front of the LRU list in place, so lookups are O(1).
+//!
+//! ```
+//! cargo run --release --example cache_lookup
+//! ```
+//!
+//! ### Perf: Sequential Record Cursor
+//!
+//! `libesedb_table_get_record` looks each record up by index, which walks the table's page tree from the root for every row, so reading a whole table costs far more than the pages it touches.
+//! `libesedb_table_get_record_cursor` returns a `libesedb_record_cursor_t` that follows the `next_page_number` chain between leaf pages instead, and `libesedb_record_cursor_next` reads the records one leaf page at a time, skipping defunct values.
+//! The page tree also remembers its first leaf page number, so it can be looked up again after the records have been counted.
+//! This patch adds a new file, so `build.rs` also creates the files of patches against `/dev/null`.
+//!
+//! ### Perf: Positioned Reads
+//!
+//! `libbfio_handle_read_buffer_at_offset` used to seek and then read, so two threads reading the same handle could move each other's file offset.
+//! `libcfile_file_read_buffer_at_offset` reads with `pread` (or `ReadFile` with an offset on Windows) without using or changing the current offset, and file and memory range handles use it through a new optional `read_at_offset` handle function.
+//! All reads in libesedb go through `libbfio_handle_read_buffer_at_offset`, so a single open file can now be read from multiple threads at the IO level.
+//! Handles that open on demand or track the offsets read keep using seek and read.
+//!
+//! ### Perf: Memory-Mapped Files
+//!
+//! `libbfio_mapped_file_initialize` creates a read-only handle that maps the whole file (`mmap`, or `MapViewOfFile` on Windows) and serves reads from the mapping.
+//! The new optional `get_data_at_offset` handle function lets `libesedb_page_read_file_io_handle` point the page data directly into the mapping instead of allocating and copying every page.
+//! Databases with the extended page format (16 KiB pages and up) still get a copy, because reading the page values modifies the page data in place.
+//! `libesedb_file_open_mmap` opens a file with this handle, and is used by `EseDb::open_mmap`.
+//! The `HAVE_MMAP` and `HAVE_SYS_MMAN_H` entries move the `HAVE_POSIX_FADVISE` line that `build.rs` changes on macOS to line 350.
+//!
+//! ### Perf: Thread-Safe Files
+//!
+//! `libesedb_file_t` takes a libcthreads read/write lock (`HAVE_LIBESEDB_MULTI_THREAD_SUPPORT`, defined in `libesedb_libcthreads.h`): open and close hold it for writing, the file getters and table lookups for reading.
+//! Once open, the file only shares the parsed catalog, IO handle and file IO handle with its tables, and these are not changed by reading.
+//! Each table handle has its own pages vectors, page caches and page trees, so one open file can hand out tables to many threads at once.
+//! A table, and the records, indexes and cursors retrieved from it, must be used by one thread at a time.
+//! Concurrent reads need a file IO handle with a positioned read function, which `libesedb_file_open`, `libesedb_file_open_wide` and `libesedb_file_open_mmap` always create.
+//!
+//! ### Perf: Leaf Page Ranges
+//!
+//! `libesedb_table_get_number_of_leaf_pages` and `libesedb_table_get_leaf_page_number` expose the leaf pages of a table, in record order, from its leaf page descriptors tree.
+//! `libesedb_table_get_record_cursor_by_leaf_page_range` creates a record cursor that starts at a given leaf page and stops after another, instead of walking the whole leaf page chain.
+//! `libesedb_table_clone` creates another handle to the same table with its own page caches, so a table can be split into leaf page ranges that are read by cursors on different threads.
+//! This is used by `Table::partitions` and `Table::par_for_each_record`.
+//!
+//! ### Perf: Lazy Record Values
+//!
+//! `libesedb_data_definition_read_record` no longer creates a `libfvalue_value_t` for every column when a record is read.
+//! It copies the record data once and reads the fixed, variable and tagged data type offsets into a flat array of value entries.
+//! The record value of a column is created on the first `libesedb_record_get_value*` call for that column, and references the copied record data instead of copying it again.
+//! The tagged data type offset reads are now bounds checked against the record data, since the copy has no page data after it to read into.
+//!
+//! ### Perf: Column Projection
+//!
+//! Adds `libesedb_record_cursor_set_column_projection`, which restricts the records read by a record cursor to a list of column entries.
+//! `libesedb_data_definition_read_record` stops reading the data type offsets once the last projected column is read, and only fills value entries for projected columns.
+//! The values of a projected record are in the order of the projection, so value entry 0 is the first projected column.
+//! A column entry that is out of range or appears twice is an argument error.
+//!
+//! ### Perf: Record Layout
+//!
+//! `libesedb_table_initialize` compiles the column catalog definitions of the table and its template table into a `libesedb_record_layout_t`.
+//! It holds the data type class and fixed size data type value offset of each column, and a lookup table from tagged data type identifier to column.
+//! `libesedb_data_definition_read_record` reads the fixed and variable size data types of a column directly at their offsets, and reads the tagged data types in the order they are stored in the record, without looking up column catalog definitions.
+//! If the catalog lists the fixed size data type identifiers out of order, their offsets are summed per record in catalog order instead, as before.
+//! Tagged data types that are not in the catalog, such as those of deleted columns, no longer stop the remaining tagged data types of the record from being read.
+//! The columns of a table using a template table now follow the template table columns, as they do for `libesedb_table_get_column`.
+//! The linear tagged data types format now skips over the value of each tagged data type to read the next one.
+//!
+//! ### Perf: SIMD Checksums
+//!
+//! `libesedb_checksum_calculate_little_endian_ecc32` hands whole 16-byte groups to a group kernel, which returns the ECC-32 bits of the groups and their vertical XOR-32 values.
+//! The SSE2 kernel transposes 4 groups into the lanes of a vector to determine their parities, the AVX2 kernel does the same for 8 groups.
+//! `libesedb_checksum_calculate_little_endian_xor32` XORs whole 16-byte blocks with SSE2 or AVX2 vectors before the aligned loop.
+//! SSE2 is used when the compiler targets it, AVX2 is selected at run-time with `__builtin_cpu_supports` on GCC and Clang.
+//! Other targets use the portable scalar code, which now checks the parity of a group with a single lookup.
+//! The `checksum` example benchmarks the kernels against the scalar implementation.
+//!
+//! ### Perf: Extended Page Checksums
+//!
+//! Pages with an extended page header, 16 and 32 KiB pages of format revision 0x11 or later, are divided into 4 blocks with a checksum each.
+//! `libesedb_page_header_read_data` now reads the checksum of the 1st block from the page header and those of the other blocks from the extended page header.
+//! `libesedb_page_calculate_checksums` calculates the checksum of the 1st block, skipping the checksum itself, and `libesedb_page_calculate_extended_checksums` those of the other blocks.
+//! The blocks are checksummed with the SIMD kernels, so a page is read once.
+//! Mismatches are reported the same way as those of other pages.
+//!
+//! ### Perf: Page Verification
+//!
+//! `libesedb_file_verify_pages` checks every page of the file without walking the page trees.
+//! The file is read sequentially in 1 MiB chunks of whole pages, referenced in place when the file is memory mapped, and the chunks are verified by a `libcthreads_thread_pool` of worker threads.
+//! A page is bad if its checksums mismatch, its stored page number differs from its position, `libesedb_page_validate_page` rejects its header or it is cut short by the end of the file.
+//! The bad pages are returned in a `libesedb_page_verifier_t` owned by the caller, so concurrent verifications do not share state, and their `LIBESEDB_PAGE_VERIFICATION_FLAGS` are retrieved with `libesedb_page_verifier_get_number_of_bad_pages` and `libesedb_page_verifier_get_bad_page`.
+//! If the file is signalled to abort, no more chunks are read and the verification fails with `LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED`, since the remaining pages are not verified.
+//! `esedbinfo -c` prints a summary and a tab separated list of the bad pages, `-j` sets the number of threads.
+//!
+//! ### Perf: 7-bit Decoder
+//!
+//! `libesedb_compression_7bit_decompress` used to emit one character per iteration through a 16-bit shift register.
+//! It now loads 8 bytes at a time and unpacks the 56 bits of every 7 compressed bytes into 8 characters, the remaining bytes use the old loop.
+//! The unpacking is a single `pdep` when the compiler targets BMI2, otherwise 3 shift and mask steps that halve the bit groups.
+//! The `compression` example benchmarks the decoder against the byte at a time implementation, on a text file given as argument or on this README.
+//!
+//! ```
+//! cargo run --release --example compression [file]
+//! ```
+//!
+//! ### Perf: Single-Pass UTF-8 Strings
+//!
+//! `libesedb_record_get_value_utf8_string_size` and `libesedb_record_get_value_utf8_string` each decompress and convert a compressed value, so reading it costs two decompressions and two conversions.
+//! `libesedb_record_get_value_utf8_string_maximum_size` returns an upper bound of the string size that is determined without decompressing the value, from the data size or the compressed data header.
+//! `libesedb_record_get_value_utf8_string_with_index` then decompresses the value into a buffer of the record, that is reused by its other values, and converts it straight into the string, returning the string size in the UTF-8 string index.
+//! `libesedb_long_value_get_utf8_string_maximum_size` and `libesedb_long_value_get_utf8_string_with_index` do the same for long values.
+//!
+//! ### Perf: LZXPRESS Decoder
+//!
+//! `libfwnt_lzxpress_decompress`, which decodes LZXPRESS compressed values (leading byte 0x18), used to test one indicator bit and copy one byte per iteration, with bounds checks on every byte.
+//! Runs of uncompressed bytes are now found from the indicator word with a count of leading zero bits and copied at once, and matches are copied 16, 8 or 4 bytes at a time once their distance allows it.
+//! The head and tail of a copy overlap instead of writing past its end, so the output is the same as before, including the bytes after the last decompressed one.
+//! The bounds are checked once per run or match, and invalid data fails with the same errors.
+//! The `compression` example also benchmarks the LZXPRESS decoder.
+//!
+//! ### Perf: UTF-16 Text Conversion
+//!
+//! `libuna_utf8_string_size_from_utf16_stream` and `libuna_utf8_string_with_index_copy_from_utf16_stream`, that convert the UTF-16 text values of records, long values and multi values, used to decode and encode every character with 2 checked libuna calls.
+//! Little-endian streams are now converted a run at a time, up to the next end-of-string character or surrogate.
+//! Runs of ASCII characters are checked and narrowed 16 at a time with SSE2 or 32 at a time with AVX2, selected the same way as for the checksums, other characters are encoded in place.
+//! Surrogates, big-endian streams and the end of the string still use the per-character conversion, so the output and the errors are the same as before.
+//! The `utf16` example benchmarks the conversion against the standard library, on a text file given as argument or on this README.
+//!
+//! ```
+//! cargo run --release --example utf16 [file]
+//! ```
+//!
+//! ### Perf: Page Binary Search
+//!
+//! `libesedb_page_tree_get_leaf_value_by_key_from_page`, that looks up index entries, records by index and long value segments, used to read and compare every page value of each page on the path from the root to the leaf.
+//! It now binary searches the page values first, and only reads the ones the search compares against.
+//! Defunct page values are skipped by the search, and the keys are compared after the common key prefix of the page is applied, as before.
+//! On a branch page the search finds the first child whose key is not less than the key, and the children after it are still tried if its child page does not contain the key.
+//! Index keys with the flexible bit set in their second byte are searched for without and then with the bit, in the order the linear scan matched them.
+//! The values found, including those of flexible index keys, are the same as before.
+//!
+//! ### Perf: Index Seek
+//!
+//! `libesedb_index_get_record` only finds an index entry by its position, so finding the records with a given key meant reading the index from its first entry onwards.
+//! `libesedb_index_seek` binary searches the index's page tree from the root down to the first entry whose key is not less than a given key, and returns a `libesedb_index_cursor_t` positioned there.
+//! `libesedb_index_cursor_next` then reads the records of the entries in index order, following the `next_page_number` chain between leaf pages, until an entry no longer matches.
+//! The key is a normalized key, the bytes stored in the index, and is compared byte by byte.
+//! `LIBESEDB_INDEX_MATCH_MODE_EQUAL` matches entries with exactly that key, `LIBESEDB_INDEX_MATCH_MODE_PREFIX` entries whose key starts with it and `LIBESEDB_INDEX_MATCH_MODE_GREATER_EQUAL` every entry from the key onwards.
+//! The keys of a non-unique index can have the primary key appended, so a key of the indexed columns alone is matched with the prefix mode.
+//!
+//! ### Perf: Index Range Scans
+//!
+//! `libesedb_index_get_cursor_by_key_range` returns an index cursor over the entries whose key is not less than a lower key and less than an upper key, so a bounded query reads only the leaf pages of its range instead of the whole table.
+//! Either key can be `NULL` for an open range, and with `LIBESEDB_INDEX_CURSOR_FLAG_INCLUDE_UPPER_KEY` the entries whose key starts with the upper key are included too.
+//! The cursor descends the index once, to the start of the range, and then follows the `next_page_number` links between leaf pages.
+//! With `LIBESEDB_INDEX_CURSOR_FLAG_REVERSE` it starts at the end of the range and follows the `previous_page_number` links, reading the entries in reverse index order.
+//! The search for a key past the last index entry now ends in the last leaf page, instead of without a leaf page, so a reverse range can start after the last entry.
+//!
+//! ### Perf: Index Keys
+//!
+//! `libesedb_index_cursor_next_key` advances an index cursor without reading the record, and returns the key of the index entry without copying it.
+//! The key points into the leaf page, which stays in the cursor's own leaf page cache until the cursor is advanced.
+//! A key stored as a common page key and a local key is assembled in a buffer of the cursor, which is reused for the following keys.
+//! `libesedb_index_cursor_get_record` then reads the record of the current entry, only for the entries that a key filter selects.
+//! Reading the keys of an index this way is about two orders of magnitude faster than reading its records.
+//!
+//! ### Perf: Long Value Reader
+//!
+//! `libesedb_long_value_read_buffer_at_offset` reads part of a long value, at an offset, into a caller buffer.
+//! It looks up the data segment that contains the offset in the mapped ranges of the data segments list, and only reads the segments that contain the requested bytes.
+//! A long value can then be streamed in pieces, with the memory use bounded by the data segments cache, instead of copying all of it into one buffer with `libesedb_long_value_get_data`.
+//!
+//! ### Perf: Long Value Segment Walk
+//!
+//! The data segments of a long value are stored in the long values page tree directly after the long value, with keys of the long value key followed by the segment offset.
+//! Only the long value itself is still looked up by key. The segments are then read by walking the leaf values that follow it, on the same leaf page and the leaf pages after it, with `libesedb_page_tree_get_next_leaf_value`, instead of searching the page tree again from the root for every segment.
+//! The walk stops at the first leaf value that is not the next segment, which also ends the segments at an empty segment instead of looking it up again forever.
+//! Opening a long value with many segments is more than an order of magnitude faster.
+//!
+//! ### Perf: Long Value Prefetch
+//!
+//! `libesedb_record_cursor_set_long_values_prefetch` makes a record cursor read ahead a batch of records and collect the long value identifiers they reference. The identifiers are sorted, and the leaf pages of the long values page tree that hold them are resolved from their parent pages. The pages that are not cached yet are read into the long values pages cache in ascending page order, and runs of adjacent pages are read with a single read of up to 1 MiB. It is off by default.
+//! The long value itself is now looked up with the key data search of the index seek patch, which goes through the pages cache, instead of by key with throw-away single page caches that read the root-to-leaf path from the file again for every long value.
+//! Long value segment data is copied from the leaf page when that page is in the pages cache, and read from the file otherwise, instead of always being read from the file.
+//! A record that cannot be read ends the batch. The cursor returns the records read before it, then the error, the same as without the prefetch.
+//! A table scan that reads 5000 small long values went from about 23000 reads to under 600, and to about 300 with prefetch, where 20 coalesced reads replace about 300 page reads.
+//!
+//! ### Perf: Cache Limits
+//!
+//! `libesedb_file_set_cache_limits` sets the maximum size, in bytes, of the page data in each kind of cache:
+//! - the pages caches of the file and the tables;
+//! - the long values pages caches of the tables;
+//! - the data segments cache of each long value.
+//!
+//! Before this, the table pages cache and the long values pages cache both held `LIBESEDB_MAXIMUM_CACHE_ENTRIES_PAGES` pages. That is up to 256 MiB each per table with 32 KiB pages, whatever the workload.
+//! libfcache counts entries, not bytes, so each size is divided by the page size to get the number of cache entries, with at least 1. Long value data segments are never larger than a page. A size of 0 keeps the default number of entries.
+//! The limits are kept in the IO handle, like the ASCII codepage. They apply to the caches created after the call, so they are normally set before `libesedb_file_open`, and they survive closing and reopening the file.
+//!
+//! ### Perf: Long Value Segment Views
+//!
+//! `libesedb_long_value_get_data_segment_view` returns a pointer into the cached page that contains a data segment, instead of copying the segment into a caller buffer like `libesedb_long_value_get_data_segment`.
+//! The page is pinned with a reference count on the page object. When libfcache evicts a pinned page, `libesedb_page_free` only marks it as freed, and the page is freed when its last pin is released.
+//! A view is released by `libesedb_long_value_release_data_segment_view` or when the long value is freed. Each segment pins its page at most once.
+//! The pin is on the page, not on the cache entry, so a long value can pin more pages than the cache holds and the cache limits still bound the cache itself.
+//!
 //!
 //! ## Updating Bundled libesedb
 //!
@@ -29,7 +29,38 @@ use crate::Table;
 
 const LIBESEDB_OPEN_READ: LIBESEDB_ACCESS_FLAGS = LIBESEDB_ACCESS_FLAGS_LIBESEDB_ACCESS_FLAG_READ;
 
+/// Maximum sizes, in bytes, of the page caches of an [`EseDb`], see [`EseDb::open_with_cache_limits`].
+/// A size of 0 keeps the default number of cache entries.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct CacheLimits {
+    /// Size of the pages cache of the database catalog and of each [`Table`].
+    pub pages: u64,
+    /// Size of the long value pages cache of each [`Table`].
+    pub long_value_pages: u64,
+    /// Size of the segment data cache of each [`crate::LongValue`].
+    pub long_value_data: u64,
+}
+
 /// A loaded instance of an ESE database.
+///
+/// The database can be shared between threads, each thread loading its own
+/// [`Table`]s from the shared catalog.
+///
+/// ```no_run
+/// use libesedb::EseDb;
+/// use std::{io, thread};
+///
+/// fn main() -> io::Result<()> {
+///     let db = EseDb::open("Catalog1.edb")?;
+///     thread::scope(|s| {
+///         for name in ["string", "Folders"] {
+///             let db = &db;
+///             s.spawn(move || db.table_by_name(name)?.count_records());
+///         }
+///     });
+///     Ok(())
+/// }
+/// ```
 pub struct EseDb {
     ptr: *mut libesedb_file_t,
 }
@@ -65,6 +96,99 @@ impl EseDb {
         Ok(Self { ptr })
     }
 
+    /// Opens an existing ESE database file, like [`EseDb::open`], with page caches
+    /// limited in bytes instead of the default number of pages. This keeps the memory
+    /// used by large tables and long values predictable, and keeps long value pages
+    /// from pushing table pages out of the cache.
+    ///
+    /// ```no_run
+    /// use libesedb::{CacheLimits, EseDb};
+    /// use std::io;
+    ///
+    /// fn main() -> io::Result<()> {
+    ///     let limits = CacheLimits {
+    ///         pages: 256 << 20,
+    ///         long_value_pages: 64 << 20,
+    ///         long_value_data: 1 << 20,
+    ///     };
+    ///     let db = EseDb::open_with_cache_limits("Catalog1.edb", limits)?;
+    ///     // ...
+    ///     Ok(())
+    /// }
+    /// ```
+    pub fn open_with_cache_limits<P: AsRef<Path>>(
+        filename: P,
+        limits: CacheLimits,
+    ) -> io::Result<Self> {
+        let filename = CString::new(&*filename.as_ref().to_string_lossy())?;
+        let mut ptr = null_mut();
+        ese_result!(libesedb_file_initialize, &mut ptr)?;
+        let mut db = Self { ptr };
+        db.set_cache_limits(limits)?;
+        ese_result!(
+            libesedb_file_open,
+            db.ptr,
+            filename.as_ptr(),
+            LIBESEDB_OPEN_READ
+        )?;
+        Ok(db)
+    }
+
+    /// Change the page cache limits, see [`CacheLimits`].
+    /// Only the [`Table`]s loaded after this use the new limits.
+    pub fn set_cache_limits(&mut self, limits: CacheLimits) -> io::Result<()> {
+        ese_result!(
+            libesedb_file_set_cache_limits,
+            self.ptr,
+            limits.pages,
+            limits.long_value_pages,
+            limits.long_value_data
+        )?;
+        Ok(())
+    }
+
+    /// Opens an existing ESE database file through a read-only memory mapping.
+    ///
+    /// Pages are read directly from the mapping instead of being copied into
+    /// separately allocated buffers.
+    ///
+    /// # Safety
+    ///
+    /// The file must not be modified or truncated, by this or any other process,
+    /// while the database is open. The pages, and the slices returned by
+    /// [`crate::IndexKeys::next_key`] and [`crate::LongValue::segment_slice`],
+    /// reference the mapped file, so changing it is undefined behavior and
+    /// reading past a truncated end can crash the process with `SIGBUS`.
+    ///
+    /// ```no_run
+    /// use libesedb::EseDb;
+    /// use std::io;
+    ///
+    /// fn main() -> io::Result<()> {
+    ///     // Safety: the file is not changed while it is open.
+    ///     let db = unsafe { EseDb::open_mmap("Catalog1.edb")? };
+    ///     // ...
+    ///     Ok(())
+    /// }
+    /// ```
+    pub unsafe fn open_mmap<P: AsRef<Path>>(filename: P) -> io::Result<Self> {
+        let filename = CString::new(&*filename.as_ref().to_string_lossy())?;
+        let mut ptr = null_mut();
+        ese_result!(libesedb_file_initialize, &mut ptr)?;
+        if let Err(e) = ese_result!(
+            libesedb_file_open_mmap,
+            ptr,
+            filename.as_ptr(),
+            LIBESEDB_OPEN_READ
+        ) {
+            unsafe {
+                libesedb_file_free(&mut ptr, null_mut());
+            }
+            return Err(e);
+        }
+        Ok(Self { ptr })
+    }
+
     /// Return underlying pointer for use with `libesedb-sys`.
     pub fn as_mut_ptr(&mut self) -> *mut libesedb_table_t {
         self.ptr
@@ -110,6 +234,109 @@ impl EseDb {
     pub fn iter_tables(&self) -> io::Result<impl Iterator<Item = io::Result<Table>>> {
         Ok((0..self.count_tables()?).map(|i| Table::load(self.ptr, i)))
     }
+
+    /// Total number of pages in the database file.
+    pub fn count_pages(&self) -> io::Result<u32> {
+        let mut n = 0;
+        ese_result!(libesedb_file_get_number_of_pages, self.ptr, &mut n)?;
+        Ok(n)
+    }
+
+    /// Verify the checksums and headers of all the pages in the database file.
+    ///
+    /// The file is read sequentially in large chunks and the pages are
+    /// verified by `threads` worker threads, or on the calling thread if
+    /// `threads` is 0. Returns the pages that failed verification, sorted by
+    /// page number. Empty (never written) pages are not verified.
+    ///
+    /// ```no_run
+    /// use libesedb::EseDb;
+    /// use std::io;
+    ///
+    /// fn main() -> io::Result<()> {
+    ///     let db = EseDb::open("Catalog1.edb")?;
+    ///     for page in db.verify_pages(4)? {
+    ///         println!("{}\t{:#04x}", page.page_number, page.flags);
+    ///     }
+    ///     Ok(())
+    /// }
+    /// ```
+    pub fn verify_pages(&self, threads: usize) -> io::Result<Vec<BadPage>> {
+        let threads = threads.min(i32::MAX as usize) as i32;
+        let mut verifier = null_mut();
+        ese_result!(libesedb_file_verify_pages, self.ptr, threads, &mut verifier)?;
+        let mut n = 0;
+        let pages = ese_result!(
+            libesedb_page_verifier_get_number_of_bad_pages,
+            verifier,
+            &mut n
+        )
+        .and_then(|_| {
+            (0..n)
+                .map(|i| {
+                    let mut page = BadPage {
+                        page_number: 0,
+                        flags: 0,
+                    };
+                    ese_result!(
+                        libesedb_page_verifier_get_bad_page,
+                        verifier,
+                        i,
+                        &mut page.page_number,
+                        &mut page.flags
+                    )?;
+                    Ok(page)
+                })
+                .collect()
+        });
+        // Safety:
+        //   The page verifier is owned by this call, the bad pages are copied out of it above
+        unsafe {
+            libesedb_page_verifier_free(&mut verifier, null_mut());
+        }
+        pages
+    }
+}
+
+/// A page that failed verification, see [`EseDb::verify_pages`].
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct BadPage {
+    /// The page number.
+    pub page_number: u32,
+    /// Combination of the `LIBESEDB_PAGE_VERIFICATION_FLAG_*` flags.
+    pub flags: u32,
+}
+
+impl BadPage {
+    fn has_flag(&self, flag: LIBESEDB_PAGE_VERIFICATION_FLAGS) -> bool {
+        self.flags & flag as u32 != 0
+    }
+
+    /// The stored checksums do not match the page contents.
+    pub fn checksum_mismatch(&self) -> bool {
+        self.has_flag(
+            LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_CHECKSUM_MISMATCH,
+        )
+    }
+
+    /// The page header is invalid.
+    pub fn invalid_header(&self) -> bool {
+        self.has_flag(
+            LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_INVALID_HEADER,
+        )
+    }
+
+    /// The page number stored in the page header does not match its position in the file.
+    pub fn page_number_mismatch(&self) -> bool {
+        self.has_flag(
+            LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_PAGE_NUMBER_MISMATCH,
+        )
+    }
+
+    /// The page is cut short by the end of the file.
+    pub fn truncated(&self) -> bool {
+        self.has_flag(LIBESEDB_PAGE_VERIFICATION_FLAGS_LIBESEDB_PAGE_VERIFICATION_FLAG_TRUNCATED)
+    }
 }
 
 impl Drop for EseDb {
@@ -122,3 +349,124 @@ impl Drop for EseDb {
         }
     }
 }
+
+// Safety:
+//  libesedb_file_t guards open/close and the catalog lookups with a read/write lock,
+//  and every table loaded from it has its own page caches and traversal state.
+//  The tables share the file IO handle, and the vendored libbfio is built with
+//  HAVE_LOCAL_LIBBFIO, which compiles out the lock of the handle. Concurrent reads
+//  are only safe on the read_at_offset fast path of libbfio_handle_read_buffer_at_offset,
+//  which does not use the offset of the handle. That path requires HAVE_PREAD or WINAPI
+//  (or a memory mapped file), a handle that is not opened on demand and no tracking
+//  of the offsets read, which libesedb only enables with HAVE_DEBUG_OUTPUT
+unsafe impl Send for EseDb {}
+unsafe impl Sync for EseDb {}
+
+#[cfg(test)]
+mod tests {
+    use crate::record::tests::{contents, CORRUPT_RECORD_EDB, ITEMS_EDB, LARGE_PAGES_EDB};
+    use crate::{CacheLimits, EseDb, Value};
+    use libesedb_sys::libesedb_file_signal_abort;
+    use std::ptr::null_mut;
+    use std::{env, fs, io, process, thread};
+
+    /// The values and long values of the records of all the tables.
+    fn scan(db: &EseDb) -> io::Result<Vec<(Vec<Value>, Vec<Vec<u8>>)>> {
+        let mut records = Vec::new();
+        for table in db.iter_tables()? {
+            for record in table?.iter_records()? {
+                records.push(contents(&record?)?);
+            }
+        }
+        Ok(records)
+    }
+
+    #[test]
+    fn test_concurrent_verify_pages() {
+        let db = EseDb::open(CORRUPT_RECORD_EDB).unwrap();
+        // The page tag of the corrupt record was changed without updating the checksum of page 30.
+        let expected = db.verify_pages(0).unwrap();
+        assert_eq!(expected.len(), 1);
+        assert_eq!(expected[0].page_number, 30);
+        assert!(expected[0].checksum_mismatch());
+        let db = &db;
+        thread::scope(|scope| {
+            let handles: Vec<_> = (0..2)
+                .map(|threads| scope.spawn(move || db.verify_pages(threads * 2)))
+                .collect();
+            for handle in handles {
+                assert_eq!(handle.join().unwrap().unwrap(), expected);
+            }
+        });
+    }
+
+    #[test]
+    fn test_aborted_verify_pages() {
+        let db = EseDb::open(ITEMS_EDB).unwrap();
+        // Safety: the file is open until db is dropped.
+        unsafe { libesedb_file_signal_abort(db.ptr, null_mut()) };
+        // The pages are not verified, so there are no bad pages to return.
+        assert!(db.verify_pages(0).is_err());
+        assert!(db.verify_pages(2).is_err());
+    }
+
+    #[test]
+    fn test_verify_extended_page_checksums() -> io::Result<()> {
+        let db = EseDb::open(LARGE_PAGES_EDB)?;
+        assert_eq!(scan(&db)?, scan(&EseDb::open(ITEMS_EDB)?)?);
+        assert_eq!(db.verify_pages(0)?, []);
+        assert_eq!(db.verify_pages(2)?, []);
+
+        // Flip a byte in the 3rd block of page 30, which is only covered by
+        // the 2nd checksum of the extended page header.
+        let mut data = fs::read(LARGE_PAGES_EDB)?;
+        data[(30 + 1) * 16384 + 2 * 4096 + 100] ^= 1;
+        let path = env::temp_dir().join(format!("libesedb-block3-{}.edb", process::id()));
+        fs::write(&path, data)?;
+        let bad_pages = EseDb::open(&path).and_then(|db| db.verify_pages(0));
+        fs::remove_file(&path)?;
+        let bad_pages = bad_pages?;
+        assert_eq!(bad_pages.len(), 1);
+        assert_eq!(bad_pages[0].page_number, 30);
+        assert!(bad_pages[0].checksum_mismatch());
+        Ok(())
+    }
+
+    #[test]
+    fn test_open_mmap() -> io::Result<()> {
+        let expected = scan(&EseDb::open(ITEMS_EDB)?)?;
+        assert!(expected.len() >= 64);
+        // Safety: the fixtures are not changed by the tests.
+        assert_eq!(scan(&unsafe { EseDb::open_mmap(ITEMS_EDB)? })?, expected);
+
+        let db = unsafe { EseDb::open_mmap(CORRUPT_RECORD_EDB)? };
+        let expected = EseDb::open(CORRUPT_RECORD_EDB)?.verify_pages(0)?;
+        assert_eq!(db.verify_pages(0)?, expected);
+        assert_eq!(db.verify_pages(2)?, expected);
+        Ok(())
+    }
+
+    #[test]
+    fn test_small_cache_limits() -> io::Result<()> {
+        let expected = scan(&EseDb::open(ITEMS_EDB)?)?;
+        // Caches of a single page or segment evict an entry on almost every read.
+        let limits = CacheLimits {
+            pages: 1,
+            long_value_pages: 1,
+            long_value_data: 1,
+        };
+        assert_eq!(
+            scan(&EseDb::open_with_cache_limits(ITEMS_EDB, limits)?)?,
+            expected
+        );
+
+        let mut db = EseDb::open(ITEMS_EDB)?;
+        db.set_cache_limits(CacheLimits {
+            pages: 2 << 12,
+            long_value_pages: 1 << 12,
+            long_value_data: 100,
+        })?;
+        assert_eq!(scan(&db)?, expected);
+        Ok(())
+    }
+}
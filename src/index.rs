@@ -0,0 +1,498 @@
+/*
+ * A safe Rust API to libesedb
+ *
+ * Copyright (C) 2022-2024, Oliver Lenehan ~sunsetkookaburra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+use libesedb_sys::*;
+use std::io;
+use std::marker::PhantomData;
+use std::ptr::{null, null_mut};
+use std::slice;
+
+use crate::error::ese_result;
+use crate::record::Record;
+
+/// Instance of a ESE database index of a currently open [`crate::Table`].
+pub struct Index<'a> {
+    ptr: *mut libesedb_index_t,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl Index<'_> {
+    /// Gets the name of the index.
+    pub fn name(&self) -> io::Result<String> {
+        let mut size = 0;
+        ese_result!(libesedb_index_get_utf8_name_size, self.ptr, &mut size)?;
+        let mut name = Vec::with_capacity(size as _);
+        ese_result!(
+            libesedb_index_get_utf8_name,
+            self.ptr,
+            name.as_mut_ptr(),
+            size
+        )?;
+        unsafe { name.set_len(size as _) }
+        name.pop();
+        String::from_utf8(name).map_err(|e| io::Error::new(io::ErrorKind::Other, e))
+    }
+
+    /// Gets the identifier (Father Data Page object identifier) of the index.
+    pub fn id(&self) -> io::Result<u32> {
+        let mut id = 0;
+        ese_result!(libesedb_index_get_identifier, self.ptr, &mut id)?;
+        Ok(id)
+    }
+
+    /// Total number of records (rows) in the index.
+    pub fn count_records(&self) -> io::Result<i32> {
+        let mut n = 0;
+        ese_result!(libesedb_index_get_number_of_records, self.ptr, &mut n)?;
+        Ok(n)
+    }
+
+    /// Load a specific record (row) by its entry number in index order.
+    /// Returned [`Record`] is bound to the lifetime of the index.
+    pub fn record(&self, entry: i32) -> io::Result<Record> {
+        let mut ptr = null_mut();
+        ese_result!(libesedb_index_get_record, self.ptr, entry, &mut ptr)?;
+        Ok(Record::from_ptr(ptr))
+    }
+
+    /// Create an iterator over all the records (rows) of the table in index order.
+    /// The [`IndexCursor`] iterator and the returned [`Record`]s
+    /// are bound to the lifetime of the index.
+    /// Records are read by following the index leaf pages, which is much faster than
+    /// loading each one with [`Index::record`].
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #
+    /// for index in table.indexes()? {
+    ///     let index = index?;
+    ///     for record in index.iter_records()? {
+    ///         println!("{:?}", record?.value(0)?);
+    ///     }
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn iter_records(&self) -> io::Result<IndexCursor> {
+        Ok(IndexCursor {
+            ptr: self.cursor()?,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    /// Create a cursor over the keys of the index, in index order, see [`IndexKeys`].
+    /// Only the index leaf pages are read, so this is much faster than [`Index::iter_records`]
+    /// when most records are filtered out by their key.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #     let index = table.index(0)?;
+    /// #
+    /// let mut keys = index.iter_keys()?;
+    /// while let Some(key) = keys.next_key() {
+    ///     if key?.starts_with(&[0x7f]) {
+    ///         println!("{:?}", keys.record()?.value(0)?);
+    ///     }
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn iter_keys(&self) -> io::Result<IndexKeys> {
+        Ok(IndexKeys {
+            ptr: self.cursor()?,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    fn cursor(&self) -> io::Result<*mut libesedb_index_cursor_t> {
+        let mut ptr = null_mut();
+        ese_result!(
+            libesedb_index_get_cursor_by_key_range,
+            self.ptr,
+            null(),
+            0,
+            null(),
+            0,
+            0,
+            &mut ptr
+        )?;
+        Ok(ptr)
+    }
+
+    pub(crate) fn load<'a>(
+        table_handle: *mut libesedb_table_t,
+        entry: i32,
+    ) -> io::Result<Index<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(libesedb_table_get_index, table_handle, entry, &mut ptr)?;
+        Ok(Index::<'a> {
+            ptr,
+            _marker: PhantomData,
+        })
+    }
+}
+
+impl Drop for Index<'_> {
+    fn drop(&mut self) {
+        unsafe {
+            libesedb_index_free(&mut self.ptr, null_mut());
+        }
+    }
+}
+
+/// Cursor over the records (rows) of a [`Index`], in index order.
+pub struct IndexCursor<'a> {
+    ptr: *mut libesedb_index_cursor_t,
+    done: bool,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl<'a> Iterator for IndexCursor<'a> {
+    type Item = io::Result<Record<'a>>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.done {
+            return None;
+        }
+        let mut ptr = null_mut();
+        match ese_result!(libesedb_index_cursor_next, self.ptr, &mut ptr) {
+            Ok(1) => Some(Ok(Record::from_ptr(ptr))),
+            Ok(_) => {
+                self.done = true;
+                None
+            }
+            // The cursor position is undefined after an error.
+            Err(e) => {
+                self.done = true;
+                Some(Err(e))
+            }
+        }
+    }
+}
+
+impl std::iter::FusedIterator for IndexCursor<'_> {}
+
+impl Drop for IndexCursor<'_> {
+    fn drop(&mut self) {
+        unsafe {
+            libesedb_index_cursor_free(&mut self.ptr, null_mut());
+        }
+    }
+}
+
+/// Cursor over the keys of a [`Index`], in index order.
+///
+/// A key is the normalized key of an index entry, as stored in the index, which sorts
+/// byte by byte. It is borrowed from the leaf page cached by the cursor, without a copy,
+/// so it is only valid until the cursor is advanced, which is why this is not an [`Iterator`].
+/// The record of the current key is only read if asked for with [`IndexKeys::record`].
+pub struct IndexKeys<'a> {
+    ptr: *mut libesedb_index_cursor_t,
+    done: bool,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl<'a> IndexKeys<'a> {
+    /// Advance to the next index entry, and return its key.
+    /// Returns `None` once there are no more index entries.
+    pub fn next_key(&mut self) -> Option<io::Result<&[u8]>> {
+        if self.done {
+            return None;
+        }
+        let mut key = null();
+        let mut size = 0;
+        match ese_result!(libesedb_index_cursor_next_key, self.ptr, &mut key, &mut size) {
+            Ok(1) if size == 0 => Some(Ok(&[])),
+            // Safety:
+            //   the key references the leaf page cache or key buffer of the cursor,
+            //   which are not changed until the cursor is advanced through &mut self
+            Ok(1) => Some(Ok(unsafe { slice::from_raw_parts(key, size) })),
+            Ok(_) => {
+                self.done = true;
+                None
+            }
+            // The cursor position is undefined after an error.
+            Err(e) => {
+                self.done = true;
+                Some(Err(e))
+            }
+        }
+    }
+
+    /// Load the record (row) of the index entry of the key last returned by [`IndexKeys::next_key`].
+    pub fn record(&self) -> io::Result<Record<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(libesedb_index_cursor_get_record, self.ptr, &mut ptr)?;
+        Ok(Record::from_ptr(ptr))
+    }
+}
+
+impl Drop for IndexKeys<'_> {
+    fn drop(&mut self) {
+        unsafe {
+            libesedb_index_cursor_free(&mut self.ptr, null_mut());
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::IndexKeys;
+    use crate::error::ese_result;
+    use crate::record::tests::{contents, CORRUPT_RECORD_EDB, ITEMS_EDB};
+    use crate::{EseDb, Index, Value};
+    use libesedb_sys::*;
+    use std::io;
+    use std::marker::PhantomData;
+    use std::ptr::{null, null_mut};
+
+    const EQUAL: LIBESEDB_INDEX_MATCH_MODES =
+        LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_EQUAL;
+    const GREATER_EQUAL: LIBESEDB_INDEX_MATCH_MODES =
+        LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_GREATER_EQUAL;
+    const PREFIX: LIBESEDB_INDEX_MATCH_MODES =
+        LIBESEDB_INDEX_MATCH_MODES_LIBESEDB_INDEX_MATCH_MODE_PREFIX;
+    const REVERSE: u8 = LIBESEDB_INDEX_CURSOR_FLAGS_LIBESEDB_INDEX_CURSOR_FLAG_REVERSE as _;
+    const INCLUDE_UPPER_KEY: u8 =
+        LIBESEDB_INDEX_CURSOR_FLAGS_LIBESEDB_INDEX_CURSOR_FLAG_INCLUDE_UPPER_KEY as _;
+
+    /// The keys of the index entries with the "Id" of their record.
+    fn entries(mut keys: IndexKeys) -> io::Result<Vec<(Vec<u8>, Value)>> {
+        let mut entries = Vec::new();
+        while let Some(key) = keys.next_key() {
+            let key = key?.to_vec();
+            entries.push((key, keys.record()?.value(0)?));
+        }
+        Ok(entries)
+    }
+
+    fn seek<'a>(
+        index: &'a Index,
+        key: &[u8],
+        match_mode: LIBESEDB_INDEX_MATCH_MODES,
+    ) -> io::Result<IndexKeys<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(
+            libesedb_index_seek,
+            index.ptr,
+            key.as_ptr(),
+            key.len(),
+            match_mode,
+            &mut ptr
+        )?;
+        Ok(IndexKeys {
+            ptr,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    fn range<'a>(
+        index: &'a Index,
+        lower_key: Option<&[u8]>,
+        upper_key: Option<&[u8]>,
+        flags: u8,
+    ) -> io::Result<IndexKeys<'a>> {
+        let (lower_key, lower_key_size) = lower_key.map_or((null(), 0), |k| (k.as_ptr(), k.len()));
+        let (upper_key, upper_key_size) = upper_key.map_or((null(), 0), |k| (k.as_ptr(), k.len()));
+        let mut ptr = null_mut();
+        ese_result!(
+            libesedb_index_get_cursor_by_key_range,
+            index.ptr,
+            lower_key,
+            lower_key_size,
+            upper_key,
+            upper_key_size,
+            flags,
+            &mut ptr
+        )?;
+        Ok(IndexKeys {
+            ptr,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    #[test]
+    fn test_seek() -> io::Result<()> {
+        let db = EseDb::open(ITEMS_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let index = table.index(0)?;
+        let all = entries(index.iter_keys()?)?;
+        assert_eq!(all.len(), 64);
+        for (i, (key, _)) in all.iter().enumerate() {
+            assert_eq!(entries(seek(&index, key, EQUAL)?)?, all[i..=i]);
+            assert_eq!(entries(seek(&index, key, GREATER_EQUAL)?)?, all[i..]);
+
+            let prefix = &key[..key.len() - 1];
+            let expected: Vec<_> = all
+                .iter()
+                .filter(|(k, _)| k.starts_with(prefix))
+                .cloned()
+                .collect();
+            assert_eq!(entries(seek(&index, prefix, PREFIX)?)?, expected);
+
+            // A key between this key and the next one.
+            let missing = [&key[..], &[0]].concat();
+            assert_eq!(entries(seek(&index, &missing, EQUAL)?)?, []);
+            assert_eq!(
+                entries(seek(&index, &missing, GREATER_EQUAL)?)?,
+                all[i + 1..]
+            );
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_key_ranges() -> io::Result<()> {
+        let db = EseDb::open(ITEMS_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let index = table.index(0)?;
+        let all = entries(index.iter_keys()?)?;
+        let n = all.len();
+        for (lower, upper) in [
+            (None, None),
+            (None, Some(20)),
+            (Some(10), None),
+            (Some(10), Some(20)),
+            (Some(0), Some(n - 1)),
+            (Some(31), Some(32)),
+            (Some(5), Some(5)),
+        ] {
+            let lower_key = lower.map(|i| &all[i].0[..]);
+            let upper_key = upper.map(|i| &all[i].0[..]);
+            let start = lower.unwrap_or(0);
+            let end = upper.unwrap_or(n);
+
+            let forward = entries(range(&index, lower_key, upper_key, 0)?)?;
+            assert_eq!(forward, all[start..end], "{lower:?}..{upper:?}");
+            let mut reverse = entries(range(&index, lower_key, upper_key, REVERSE)?)?;
+            reverse.reverse();
+            assert_eq!(reverse, forward, "{lower:?}..{upper:?} reversed");
+
+            // The keys have the same size, so only the upper key starts with itself.
+            if upper.is_some() {
+                let end = end + 1;
+                let forward = entries(range(&index, lower_key, upper_key, INCLUDE_UPPER_KEY)?)?;
+                assert_eq!(forward, all[start..end], "{lower:?}..={upper:?}");
+                let flags = REVERSE | INCLUDE_UPPER_KEY;
+                let mut reverse = entries(range(&index, lower_key, upper_key, flags)?)?;
+                reverse.reverse();
+                assert_eq!(reverse, forward, "{lower:?}..={upper:?} reversed");
+            }
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_iter_records_in_key_order() -> io::Result<()> {
+        let db = EseDb::open(ITEMS_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let index = table.index(0)?;
+        let records = index
+            .iter_records()?
+            .map(|record| {
+                let record = record?;
+                Ok((record.value(0)?, record.value(1)?))
+            })
+            .collect::<io::Result<Vec<_>>>()?;
+        assert_eq!(records.len(), index.count_records()? as usize);
+        assert!(records.windows(2).all(|w| w[0].1 <= w[1].1));
+
+        let mut ids: Vec<_> = records.iter().map(|(id, _)| id.clone()).collect();
+        ids.sort_by(|a, b| a.partial_cmp(b).unwrap());
+        let expected: Vec<_> = (0..64).map(Value::I32).collect();
+        assert_eq!(ids, expected);
+
+        let keys = entries(index.iter_keys()?)?;
+        let key_ids: Vec<_> = keys.iter().map(|(_, id)| id).collect();
+        let record_ids: Vec<_> = records.iter().map(|(id, _)| id).collect();
+        assert_eq!(key_ids, record_ids);
+        Ok(())
+    }
+
+    #[test]
+    fn test_iter_keys_in_order() -> io::Result<()> {
+        // The keys are only read from the index, so the corrupt record does not matter.
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let index = table.index(0)?;
+        let mut keys = index.iter_keys()?;
+        let mut previous = Vec::new();
+        let mut count = 0;
+        while let Some(key) = keys.next_key() {
+            let key = key?;
+            assert!(previous.as_slice() <= key);
+            previous = key.to_vec();
+            count += 1;
+        }
+        assert_eq!(count, index.count_records()?);
+        Ok(())
+    }
+
+    #[test]
+    fn test_key_lookups_match_sequential_scan() -> io::Result<()> {
+        let db = EseDb::open(ITEMS_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let mut scan = Vec::new();
+        for record in table.iter_records()? {
+            scan.push(contents(&record?)?);
+        }
+        assert_eq!(scan.len(), 64);
+        // The table is sorted by "Id", the primary key.
+        for (id, (values, _)) in scan.iter().enumerate() {
+            assert_eq!(values[0], Value::I32(id as i32));
+        }
+        assert!(scan.iter().any(|(_, long_values)| !long_values.is_empty()));
+
+        // The records of the index entries, and their long values, are found by key.
+        let index = table.index(0)?;
+        let mut keys = index.iter_keys()?;
+        let mut records = index.iter_records()?;
+        let mut entry = 0;
+        while let Some(key) = keys.next_key() {
+            let key = key?.to_vec();
+            let record = contents(&records.next().unwrap()?)?;
+            let Value::I32(id) = record.0[0] else {
+                panic!("invalid Id {:?}", record.0[0]);
+            };
+            assert_eq!(record, scan[id as usize]);
+            assert_eq!(contents(&index.record(entry)?)?, record);
+            let mut sought = seek(&index, &key, EQUAL)?;
+            sought.next_key().unwrap()?;
+            assert_eq!(contents(&sought.record()?)?, record);
+            entry += 1;
+        }
+        assert!(records.next().is_none());
+        assert_eq!(entry, 64);
+        Ok(())
+    }
+}
@@ -45,6 +45,7 @@
 mod column;
 mod db;
 mod error;
+mod index;
 mod long_value;
 mod multi_value;
 mod record;
@@ -53,6 +54,7 @@ mod value;
 
 pub use column::*;
 pub use db::*;
+pub use index::*;
 pub use long_value::*;
 pub use multi_value::*;
 pub use record::*;
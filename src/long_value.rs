@@ -18,11 +18,13 @@
  */
 
 use libesedb_sys::*;
-use std::io;
+use std::io::{self, Read, Seek, SeekFrom};
 use std::marker::PhantomData;
-use std::ptr::null_mut;
+use std::ptr::{null, null_mut};
+use std::slice;
 
 use crate::error::ese_result;
+use crate::value::read_utf8_string;
 use crate::Value;
 
 pub struct LongValue<'a> {
@@ -63,6 +65,41 @@ impl LongValue<'_> {
         self.typ.clone()
     }
 
+    /// Gets the size of the data in bytes.
+    pub fn size(&self) -> io::Result<u64> {
+        let mut size = 0;
+        ese_result!(libesedb_long_value_get_data_size, self.ptr, &mut size)?;
+        Ok(size)
+    }
+
+    /// Create a reader over the data, which only reads the segments
+    /// that contain the requested bytes, so a large value can be streamed
+    /// or read in part without holding all of it in memory, unlike [`LongValue::vec`].
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #     let record = table.record(0)?;
+    /// #
+    /// let long_value = record.long(1)?;
+    /// let mut file = std::fs::File::create("attachment.bin")?;
+    /// io::copy(&mut long_value.reader()?, &mut file)?;
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn reader(&self) -> io::Result<LongValueReader> {
+        Ok(LongValueReader {
+            ptr: self.ptr,
+            size: self.size()?,
+            position: 0,
+            _marker: PhantomData,
+        })
+    }
+
     pub fn vec(&self) -> io::Result<Vec<u8>> {
         let mut size = 0;
         ese_result!(libesedb_long_value_get_data_size, self.ptr, &mut size)?;
@@ -80,19 +117,20 @@ impl LongValue<'_> {
     pub fn utf8(&self) -> io::Result<String> {
         let mut size = 0;
         ese_result!(
-            libesedb_long_value_get_utf8_string_size,
+            libesedb_long_value_get_utf8_string_maximum_size,
             self.ptr,
             &mut size
         )?;
-        let mut text = Vec::with_capacity(size as _);
-        ese_result!(
-            libesedb_long_value_get_utf8_string,
-            self.ptr,
-            text.as_mut_ptr(),
-            size
-        )?;
-        unsafe { text.set_len(size as _) };
-        text.pop(); // remove nul byte
+        let text = read_utf8_string(size, |data, index| {
+            ese_result!(
+                libesedb_long_value_get_utf8_string_with_index,
+                self.ptr,
+                data,
+                size,
+                index
+            )
+        })?
+        .unwrap_or_default();
         String::from_utf8(text).map_err(|e| io::Error::new(io::ErrorKind::Other, e))
     }
 
@@ -129,6 +167,54 @@ impl LongValue<'_> {
     pub fn iter_segments(&self) -> io::Result<impl Iterator<Item = io::Result<Vec<u8>>> + '_> {
         Ok((0..self.count_segments()?).map(|i| self.segment(i)))
     }
+
+    /// Gets the data of a segment without copying it, see [`LongValue::iter_segment_slices`].
+    pub fn segment_slice(&self, entry: i32) -> io::Result<&[u8]> {
+        let mut data = null();
+        let mut size = 0;
+        ese_result!(
+            libesedb_long_value_get_data_segment_view,
+            self.ptr,
+            entry,
+            &mut data,
+            &mut size
+        )?;
+        if size == 0 {
+            return Ok(&[]);
+        }
+        // Safety:
+        //   the data references a page that stays pinned until the view is released,
+        //   which only happens when the long value is dropped
+        Ok(unsafe { slice::from_raw_parts(data, size) })
+    }
+
+    /// Create an iterator over the segments of the data, like [`LongValue::iter_segments`],
+    /// that borrows each segment from the cached page that contains it instead of copying
+    /// it into a new `Vec`. These pages stay pinned in memory until the long value is dropped,
+    /// so use [`LongValue::reader`] to stream a value that is too large to keep in memory.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #     let record = table.record(0)?;
+    /// #
+    /// let long_value = record.long(1)?;
+    /// let mut checksum = 0u32;
+    /// for segment in long_value.iter_segment_slices()? {
+    ///     for &byte in segment? {
+    ///         checksum = checksum.rotate_left(5) ^ byte as u32;
+    ///     }
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn iter_segment_slices(&self) -> io::Result<impl Iterator<Item = io::Result<&[u8]>> + '_> {
+        Ok((0..self.count_segments()?).map(|i| self.segment_slice(i)))
+    }
 }
 
 impl Drop for LongValue<'_> {
@@ -138,3 +224,215 @@ impl Drop for LongValue<'_> {
         }
     }
 }
+
+/// Reader over the data of a [`LongValue`], created with [`LongValue::reader`].
+pub struct LongValueReader<'a> {
+    ptr: *mut libesedb_long_value_t,
+    size: u64,
+    position: u64,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl Read for LongValueReader<'_> {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if buf.is_empty() || self.position >= self.size {
+            return Ok(0);
+        }
+        let n = ese_result!(
+            libesedb_long_value_read_buffer_at_offset,
+            self.ptr,
+            buf.as_mut_ptr(),
+            buf.len(),
+            self.position as _
+        )? as usize;
+        self.position += n as u64;
+        Ok(n)
+    }
+}
+
+impl Seek for LongValueReader<'_> {
+    fn seek(&mut self, pos: SeekFrom) -> io::Result<u64> {
+        let position = match pos {
+            SeekFrom::Start(offset) => Some(offset),
+            SeekFrom::End(offset) => self.size.checked_add_signed(offset),
+            SeekFrom::Current(offset) => self.position.checked_add_signed(offset),
+        };
+        match position {
+            Some(position) => {
+                self.position = position;
+                Ok(position)
+            }
+            None => Err(io::Error::new(
+                io::ErrorKind::InvalidInput,
+                "invalid seek to a negative or overflowing position",
+            )),
+        }
+    }
+
+    fn stream_position(&mut self) -> io::Result<u64> {
+        Ok(self.position)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use crate::record::tests::{COMPRESSED_TEXT_EDB, CORRUPT_RECORD_EDB, ITEMS_EDB};
+    use crate::{CacheLimits, EseDb, LongValue, Table, Value};
+    use std::io::{self, Read, Seek, SeekFrom};
+
+    /// Calls `f` with the "Note" long value of every 4th record. The records are read
+    /// with [`Table::record`] since a cursor stops at the corrupt record.
+    fn for_each_long_value<F>(table: &Table, mut f: F) -> io::Result<()>
+    where
+        F: FnMut(LongValue) -> io::Result<()>,
+    {
+        let mut count = 0;
+        for entry in 0..table.count_records()? {
+            let Ok(record) = table.record(entry) else {
+                continue;
+            };
+            if record.is_long(4)? {
+                f(record.long(4)?)?;
+                count += 1;
+            }
+        }
+        assert_eq!(count, 16);
+        Ok(())
+    }
+
+    #[test]
+    fn test_reader() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        for_each_long_value(&table, |long_value| {
+            let data = long_value.vec()?;
+            let size = data.len() as u64;
+            let mut reader = long_value.reader()?;
+            let mut buf = Vec::new();
+            reader.read_to_end(&mut buf)?;
+            assert_eq!(buf, data);
+
+            reader.rewind()?;
+            buf.clear();
+            assert_eq!(io::copy(&mut reader, &mut buf)?, size);
+            assert_eq!(buf, data);
+
+            // Reads smaller than a segment straddle every segment boundary.
+            reader.rewind()?;
+            buf.clear();
+            let mut chunk = [0; 7];
+            loop {
+                let n = reader.read(&mut chunk)?;
+                if n == 0 {
+                    break;
+                }
+                buf.extend_from_slice(&chunk[..n]);
+            }
+            assert_eq!(buf, data);
+
+            let boundary = long_value.segment(0)?.len() as u64;
+            if long_value.count_segments()? > 1 {
+                assert_eq!(reader.seek(SeekFrom::Start(boundary - 5))?, boundary - 5);
+                let mut straddle = [0; 10];
+                reader.read_exact(&mut straddle)?;
+                assert_eq!(straddle[..], data[boundary as usize - 5..][..10]);
+                assert_eq!(reader.seek(SeekFrom::Current(-3))?, boundary + 2);
+                reader.read_exact(&mut straddle[..1])?;
+                assert_eq!(straddle[0], data[boundary as usize + 2]);
+            }
+
+            for n in [1, size / 2, size] {
+                assert_eq!(reader.seek(SeekFrom::End(-(n as i64)))?, size - n);
+                buf.clear();
+                reader.read_to_end(&mut buf)?;
+                assert_eq!(buf, data[(size - n) as usize..]);
+            }
+
+            assert_eq!(reader.seek(SeekFrom::End(10))?, size + 10);
+            assert_eq!(reader.read(&mut chunk)?, 0);
+            assert_eq!(reader.seek(SeekFrom::Start(size))?, size);
+            assert_eq!(reader.read(&mut chunk)?, 0);
+            let error = reader.seek(SeekFrom::End(-(size as i64) - 1)).unwrap_err();
+            assert_eq!(error.kind(), io::ErrorKind::InvalidInput);
+            Ok(())
+        })
+    }
+
+    #[test]
+    fn test_segment_slices() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        for_each_long_value(&table, |long_value| {
+            let data = long_value.vec()?;
+            let slices = long_value
+                .iter_segment_slices()?
+                .collect::<io::Result<Vec<_>>>()?;
+            assert_eq!(slices.len() as i32, long_value.count_segments()?);
+            for (entry, slice) in slices.iter().enumerate() {
+                assert_eq!(*slice, long_value.segment(entry as i32)?);
+            }
+            assert_eq!(slices.concat(), data);
+            Ok(())
+        })
+    }
+
+    #[test]
+    fn test_segment_slices_outlive_eviction() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let data = table.record(62)?.long(4)?.vec()?;
+
+        // The caches hold a single page, so reading other long values evicts the pages
+        // of the slices, which stay valid because they are pinned by the long value.
+        let limits = CacheLimits {
+            pages: 1,
+            long_value_pages: 1,
+            long_value_data: 1,
+        };
+        let small_db = EseDb::open_with_cache_limits(CORRUPT_RECORD_EDB, limits)?;
+        let small_table = small_db.table_by_name("Items")?;
+        let record = small_table.record(62)?;
+        let long_value = record.long(4)?;
+        let slices = long_value
+            .iter_segment_slices()?
+            .collect::<io::Result<Vec<_>>>()?;
+        for_each_long_value(&small_table, |other| {
+            other
+                .iter_segment_slices()?
+                .try_for_each(|slice| slice.map(drop))
+        })?;
+        assert_eq!(slices.concat(), data);
+        Ok(())
+    }
+
+    /// The "Note" value of every record, with the text of its long value.
+    fn notes(path: &str) -> io::Result<Vec<(Value, Option<String>)>> {
+        let db = EseDb::open(path)?;
+        let table = db.table_by_name("Items")?;
+        let mut notes = Vec::new();
+        for record in table.iter_records()? {
+            let record = record?;
+            if record.is_long(4)? {
+                notes.push((Value::Null(()), Some(record.long(4)?.utf8()?)));
+            } else {
+                notes.push((record.value(4)?, None));
+            }
+        }
+        Ok(notes)
+    }
+
+    #[test]
+    fn test_compressed_text() -> io::Result<()> {
+        let expected = notes(ITEMS_EDB)?;
+        let notes = notes(COMPRESSED_TEXT_EDB)?;
+        assert_eq!(notes, expected);
+        assert_eq!(notes[0].0, Value::LargeText("note for 0".into()));
+        assert_eq!(notes[3].0, Value::LargeText("note for 3".into()));
+        assert_eq!(
+            notes[2].1.as_deref(),
+            Some("long note for 2 ".repeat(3).as_str())
+        );
+        assert_eq!(notes.iter().filter(|note| note.1.is_some()).count(), 16);
+        Ok(())
+    }
+}
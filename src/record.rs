@@ -101,6 +101,13 @@ impl Record<'_> {
             _marker: PhantomData,
         })
     }
+
+    pub(crate) fn from_ptr<'a>(ptr: *mut libesedb_record_t) -> Record<'a> {
+        Record::<'a> {
+            ptr,
+            _marker: PhantomData,
+        }
+    }
 }
 
 impl Drop for Record<'_> {
@@ -110,3 +117,300 @@ impl Drop for Record<'_> {
         }
     }
 }
+
+/// Cursor over the records (rows) of a [`crate::Table`], in leaf page order.
+/// Reading records through the cursor avoids seeking the table page tree for every record.
+pub struct RecordCursor<'a> {
+    ptr: *mut libesedb_record_cursor_t,
+    done: bool,
+    _marker: PhantomData<&'a ()>,
+}
+
+impl RecordCursor<'_> {
+    pub(crate) fn load<'a>(table_handle: *mut libesedb_table_t) -> io::Result<RecordCursor<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(libesedb_table_get_record_cursor, table_handle, &mut ptr)?;
+        Ok(RecordCursor::<'a> {
+            ptr,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    pub(crate) fn load_range<'a>(
+        table_handle: *mut libesedb_table_t,
+        first_leaf_page: u32,
+        last_leaf_page: u32,
+    ) -> io::Result<RecordCursor<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(
+            libesedb_table_get_record_cursor_by_leaf_page_range,
+            table_handle,
+            first_leaf_page,
+            last_leaf_page,
+            &mut ptr
+        )?;
+        Ok(RecordCursor::<'a> {
+            ptr,
+            done: false,
+            _marker: PhantomData,
+        })
+    }
+
+    /// Only read the columns with the given entry numbers, in that order,
+    /// for the records returned after this.
+    pub(crate) fn set_column_projection(&mut self, column_entries: &[i32]) -> io::Result<()> {
+        ese_result!(
+            libesedb_record_cursor_set_column_projection,
+            self.ptr,
+            column_entries.as_ptr(),
+            column_entries.len() as _
+        )?;
+        Ok(())
+    }
+
+    /// Read ahead `records` records at a time and prefetch their long values,
+    /// so the long value pages they need are read in ascending page order,
+    /// with a single read for adjacent pages, instead of one page at a time as each
+    /// record is decoded. This mostly helps on slow or network storage. 0 disables it.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #
+    /// let mut records = table.iter_records()?;
+    /// records.prefetch_long_values(1024)?;
+    /// for record in records {
+    ///     println!("{:?}", record?.value(0)?);
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn prefetch_long_values(&mut self, records: u16) -> io::Result<()> {
+        ese_result!(
+            libesedb_record_cursor_set_long_values_prefetch,
+            self.ptr,
+            records as _
+        )?;
+        Ok(())
+    }
+}
+
+impl<'a> Iterator for RecordCursor<'a> {
+    type Item = io::Result<Record<'a>>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.done {
+            return None;
+        }
+        let mut ptr = null_mut();
+        match ese_result!(libesedb_record_cursor_next, self.ptr, &mut ptr) {
+            Ok(1) => Some(Ok(Record {
+                ptr,
+                _marker: PhantomData,
+            })),
+            Ok(_) => {
+                self.done = true;
+                None
+            }
+            // The cursor position is undefined after an error.
+            Err(e) => {
+                self.done = true;
+                Some(Err(e))
+            }
+        }
+    }
+}
+
+impl std::iter::FusedIterator for RecordCursor<'_> {}
+
+impl Drop for RecordCursor<'_> {
+    fn drop(&mut self) {
+        unsafe {
+            libesedb_record_cursor_free(&mut self.ptr, null_mut());
+        }
+    }
+}
+
+#[cfg(test)]
+pub(crate) mod tests {
+    use super::Record;
+    use crate::{EseDb, Value};
+    use std::io;
+
+    /// The "Items" table has 64 records, with a long value for every 4th record.
+    /// The page tag of the 41st record has a size of 1, so that record cannot be read.
+    pub(crate) const CORRUPT_RECORD_EDB: &str =
+        concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/corrupt_record.edb");
+
+    /// A copy of corrupt_record.edb with the identifiers of the fixed size columns
+    /// "Id" and "Value" swapped in the catalog, so they are listed out of order.
+    pub(crate) const UNORDERED_COLUMNS_EDB: &str = concat!(
+        env!("CARGO_MANIFEST_DIR"),
+        "/tests/data/unordered_columns.edb"
+    );
+
+    /// A copy of corrupt_record.edb with the size of the page tag of the 41st record
+    /// restored, so all its records can be read. The "ByValue" index sorts them by "Value".
+    pub(crate) const ITEMS_EDB: &str = concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/items.edb");
+
+    /// A copy of items.edb with 16 KiB pages at format revision 0x14. Every page has an
+    /// extended page header with the checksums of its 2nd, 3rd and 4th 4 KiB block.
+    pub(crate) const LARGE_PAGES_EDB: &str =
+        concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/large_pages.edb");
+
+    /// A copy of items.edb where "Note" is a Unicode column and all its values are compressed.
+    /// The values of every other record are 7-bit compressed, the others and the long values
+    /// are LZXPRESS compressed UTF-16.
+    pub(crate) const COMPRESSED_TEXT_EDB: &str = concat!(
+        env!("CARGO_MANIFEST_DIR"),
+        "/tests/data/compressed_text.edb"
+    );
+
+    /// A copy of items.edb where "Note" has tagged data type identifier 257. Every record
+    /// starts its tagged data types with a value of the deleted column 256.
+    const DELETED_COLUMN_EDB: &str =
+        concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/deleted_column.edb");
+
+    /// A copy of deleted_column.edb at format revision 2, so its tagged data types are
+    /// stored in the linear format: the value of column 256 comes before that of "Note".
+    const LINEAR_TAGGED_EDB: &str =
+        concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/linear_tagged.edb");
+
+    /// A copy of items.edb where the columns of "Items" belong to the template table
+    /// "ItemsTemplate". "Items" adds the tagged column "Label" with identifier 257,
+    /// which has the value "label-N" in every even record.
+    const TEMPLATE_TABLE_EDB: &str =
+        concat!(env!("CARGO_MANIFEST_DIR"), "/tests/data/template_table.edb");
+
+    /// The values of a record and the data of its long values.
+    pub(crate) fn contents(record: &Record) -> io::Result<(Vec<Value>, Vec<Vec<u8>>)> {
+        let mut long_values = Vec::new();
+        for entry in 0..record.count_values()? {
+            if record.is_long(entry)? {
+                long_values.push(record.long(entry)?.vec()?);
+            }
+        }
+        Ok((
+            record.iter_values()?.collect::<io::Result<_>>()?,
+            long_values,
+        ))
+    }
+
+    fn count_records_before_error(prefetch: u16) -> usize {
+        let db = EseDb::open(CORRUPT_RECORD_EDB).unwrap();
+        let table = db.table_by_name("Items").unwrap();
+        let mut records = table.iter_records().unwrap();
+        records.prefetch_long_values(prefetch).unwrap();
+        let mut count = 0;
+        for record in records {
+            match record {
+                Ok(_) => count += 1,
+                Err(_) => return count,
+            }
+        }
+        panic!("the corrupt record was read");
+    }
+
+    #[test]
+    fn test_prefetch_returns_records_before_error() {
+        assert_eq!(count_records_before_error(0), 40);
+        assert_eq!(count_records_before_error(16), 40);
+    }
+
+    #[test]
+    fn test_unordered_fixed_size_columns() {
+        // The fixed size data types are stored in the order of the catalog,
+        // so both files have the same values.
+        let db = EseDb::open(CORRUPT_RECORD_EDB).unwrap();
+        let table = db.table_by_name("Items").unwrap();
+        let unordered_db = EseDb::open(UNORDERED_COLUMNS_EDB).unwrap();
+        let unordered_table = unordered_db.table_by_name("Items").unwrap();
+        assert_eq!(unordered_table.column(0).unwrap().id().unwrap(), 2);
+        assert_eq!(unordered_table.column(1).unwrap().id().unwrap(), 1);
+
+        let records = table.iter_records().unwrap();
+        let unordered_records = unordered_table.iter_records().unwrap();
+        let mut count = 0;
+        for (record, unordered_record) in records.zip(unordered_records) {
+            let (Ok(record), Ok(unordered_record)) = (record, unordered_record) else {
+                break;
+            };
+            for entry in 0..2 {
+                assert_eq!(
+                    record.value(entry).unwrap(),
+                    unordered_record.value(entry).unwrap()
+                );
+            }
+            count += 1;
+        }
+        assert_eq!(count, 40);
+
+        // The value offset also counts the columns that are not projected.
+        let records = table.iter_records_projected(&["Value"]).unwrap();
+        let unordered_records = unordered_table.iter_records_projected(&["Value"]).unwrap();
+        for (record, unordered_record) in records.zip(unordered_records).take(40) {
+            assert_eq!(
+                record.unwrap().value(0).unwrap(),
+                unordered_record.unwrap().value(0).unwrap()
+            );
+        }
+    }
+
+    /// The contents of the records of the "Items" table.
+    fn items_contents(path: &str) -> Vec<(Vec<Value>, Vec<Vec<u8>>)> {
+        let db = EseDb::open(path).unwrap();
+        let table = db.table_by_name("Items").unwrap();
+        let records = table.iter_records().unwrap();
+        records
+            .map(|record| contents(&record.unwrap()).unwrap())
+            .collect()
+    }
+
+    #[test]
+    fn test_tagged_values_after_deleted_column() {
+        // Before the record layout, the value of the deleted column hid "Note" and it was NULL.
+        let expected = items_contents(ITEMS_EDB);
+        assert_eq!(expected.len(), 64);
+        assert_eq!(items_contents(DELETED_COLUMN_EDB), expected);
+    }
+
+    #[test]
+    fn test_linear_tagged_data_types() {
+        // "Note" is only found by skipping over the value of the deleted column.
+        assert_eq!(items_contents(LINEAR_TAGGED_EDB), items_contents(ITEMS_EDB));
+    }
+
+    #[test]
+    fn test_template_table_columns() {
+        // Before the record layout, records of a table with more columns than
+        // its template table could not be read.
+        let db = EseDb::open(TEMPLATE_TABLE_EDB).unwrap();
+        let table = db.table_by_name("Items").unwrap();
+        let names = table
+            .iter_columns()
+            .unwrap()
+            .map(|column| column.unwrap().name().unwrap())
+            .collect::<Vec<_>>();
+        assert_eq!(names, ["Id", "Value", "Name", "Blob", "Note", "Label"]);
+
+        let expected = items_contents(ITEMS_EDB);
+        let contents = items_contents(TEMPLATE_TABLE_EDB);
+        assert_eq!(contents.len(), expected.len());
+        for (n, ((values, long_values), (expected_values, expected_long_values))) in
+            contents.into_iter().zip(expected).enumerate()
+        {
+            assert_eq!(values[..5], expected_values[..]);
+            assert_eq!(long_values, expected_long_values);
+            let label = match n % 2 {
+                0 => Value::Text(format!("label-{n}")),
+                _ => Value::Null(()),
+            };
+            assert_eq!(values[5], label);
+        }
+    }
+}
@@ -20,12 +20,15 @@
 use libesedb_sys::*;
 use std::io;
 use std::marker::PhantomData;
+use std::panic;
 use std::ptr::null_mut;
+use std::thread;
 
 use crate::column::Column;
 use crate::error::ese_result;
+use crate::index::Index;
 // use crate::iter::{IterEntries, LoadEntry};
-use crate::record::Record;
+use crate::record::{Record, RecordCursor};
 
 /// Instance of a ESE database table in a currently open [`crate::EseDb`].
 pub struct Table<'a> {
@@ -84,6 +87,13 @@ impl Table<'_> {
         Ok(n)
     }
 
+    /// Total number of indexes of the table.
+    pub fn count_indexes(&self) -> io::Result<i32> {
+        let mut n = 0;
+        ese_result!(libesedb_table_get_number_of_indexes, self.ptr, &mut n)?;
+        Ok(n)
+    }
+
     /// Load a specific column by entry number.
     /// Returned [`Column`] is bound to the lifetime of the database table.
     pub fn column(&self, entry: i32) -> io::Result<Column> {
@@ -118,9 +128,39 @@ impl Table<'_> {
         Ok((0..self.count_columns()?).map(|i| Column::load(self.ptr, i)))
     }
 
+    /// Load a specific index by entry number.
+    /// Returned [`Index`] is bound to the lifetime of the database table.
+    pub fn index(&self, entry: i32) -> io::Result<Index> {
+        Index::load(self.ptr, entry)
+    }
+
+    /// Create an iterator over all the indexes of the table.
+    /// The returned [`Index`]es are bound to the lifetime of the database table.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #
+    /// for index in table.indexes()? {
+    ///     let index = index?;
+    ///     println!("{} ({} records)", index.name()?, index.count_records()?);
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn indexes(&self) -> io::Result<impl Iterator<Item = io::Result<Index>>> {
+        Ok((0..self.count_indexes()?).map(|i| Index::load(self.ptr, i)))
+    }
+
     /// Create an iterator over all the records (rows) in the table.
-    /// The [`IterEntries`] iterator and the returned [`Record`]s
+    /// The [`RecordCursor`] iterator and the returned [`Record`]s
     /// are bound to the lifetime of the database table.
+    /// Records are read in leaf page order, which is much faster than
+    /// loading each one with [`Table::record`].
     ///
     /// ```no_run
     /// # use libesedb::EseDb;
@@ -139,8 +179,48 @@ impl Table<'_> {
     /// #     Ok(())
     /// # }
     /// ```
-    pub fn iter_records(&self) -> io::Result<impl Iterator<Item = io::Result<Record>>> {
-        Ok((0..self.count_records()?).map(|i| Record::load(self.ptr, i)))
+    pub fn iter_records(&self) -> io::Result<RecordCursor> {
+        RecordCursor::load(self.ptr)
+    }
+
+    /// Create an iterator over the records (rows) in the table, like [`Table::iter_records`],
+    /// that only reads the named columns. The returned [`Record`]s only contain the values
+    /// of these columns, in the same order, and the other columns are skipped when a
+    /// record is read, which makes reading a few columns of a wide table much faster.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("ntds.dit")?;
+    /// #     let table = db.table_by_name("datatable")?;
+    /// #
+    /// for record in table.iter_records_projected(&["ATTm3", "ATTq131091"])? {
+    ///     let record = record?;
+    ///     println!("{:?} {:?}", record.value(0)?, record.value(1)?);
+    /// }
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn iter_records_projected(&self, columns: &[&str]) -> io::Result<RecordCursor> {
+        let mut names = Vec::with_capacity(self.count_columns()? as _);
+        for column in self.iter_columns()? {
+            names.push(column?.name()?);
+        }
+        let column_entries = columns
+            .iter()
+            .map(|&name| match names.iter().position(|n| n == name) {
+                Some(entry) => Ok(entry as i32),
+                None => Err(io::Error::new(
+                    io::ErrorKind::Other,
+                    format!("Can't find column '{name}'"),
+                )),
+            })
+            .collect::<io::Result<Vec<_>>>()?;
+        let mut cursor = RecordCursor::load(self.ptr)?;
+        cursor.set_column_projection(&column_entries)?;
+        Ok(cursor)
     }
 
     #[deprecated]
@@ -157,6 +237,97 @@ impl Table<'_> {
     }
 }
 
+impl<'a> Table<'a> {
+    /// Load another instance of the same table, with its own page caches,
+    /// so it can be read on another thread.
+    pub fn try_clone(&self) -> io::Result<Table<'a>> {
+        let mut ptr = null_mut();
+        ese_result!(libesedb_table_clone, &mut ptr, self.ptr)?;
+        Ok(Table {
+            ptr,
+            _marker: PhantomData,
+        })
+    }
+
+    /// Split the table into at most `n` partitions of consecutive leaf pages,
+    /// in record order. Each [`TablePartition`] has its own instance of the table,
+    /// so the partitions can be read on different threads.
+    pub fn partitions(&self, n: usize) -> io::Result<Vec<TablePartition<'a>>> {
+        let mut count = 0;
+        ese_result!(libesedb_table_get_number_of_leaf_pages, self.ptr, &mut count)?;
+        let count = count as usize;
+        let n = n.clamp(1, count.max(1));
+        let mut partitions = Vec::with_capacity(n);
+        for i in 0..n {
+            let (start, end) = (i * count / n, (i + 1) * count / n);
+            if start == end {
+                continue;
+            }
+            let (mut first_leaf_page, mut last_leaf_page) = (0, 0);
+            ese_result!(
+                libesedb_table_get_leaf_page_number,
+                self.ptr,
+                start as _,
+                &mut first_leaf_page
+            )?;
+            ese_result!(
+                libesedb_table_get_leaf_page_number,
+                self.ptr,
+                (end - 1) as _,
+                &mut last_leaf_page
+            )?;
+            partitions.push(TablePartition {
+                table: self.try_clone()?,
+                first_leaf_page,
+                last_leaf_page,
+            });
+        }
+        Ok(partitions)
+    }
+
+    /// Call `f` for every record (row) in the table, reading [`Table::partitions`]
+    /// of the table on up to `threads` threads. The records of a partition are
+    /// passed to `f` in order, but the partitions are read at the same time.
+    /// Returns the first error, once all threads have finished.
+    ///
+    /// ```no_run
+    /// # use libesedb::EseDb;
+    /// # use std::io;
+    /// # use std::sync::atomic::{AtomicUsize, Ordering};
+    /// # fn main() -> io::Result<()> {
+    /// #     let db = EseDb::open("Catalog1.edb")?;
+    /// #     let table = db.table(0)?;
+    /// #
+    /// let values = AtomicUsize::new(0);
+    /// table.par_for_each_record(8, |record| {
+    ///     values.fetch_add(record.count_values()? as usize, Ordering::Relaxed);
+    ///     Ok(())
+    /// })?;
+    /// #
+    /// #     Ok(())
+    /// # }
+    /// ```
+    pub fn par_for_each_record<F>(&self, threads: usize, f: F) -> io::Result<()>
+    where
+        F: Fn(Record) -> io::Result<()> + Sync,
+    {
+        let partitions = self.partitions(threads)?;
+        let f = &f;
+        thread::scope(|s| {
+            let workers: Vec<_> = partitions
+                .into_iter()
+                .map(|partition| {
+                    s.spawn(move || partition.iter_records()?.try_for_each(|r| f(r?)))
+                })
+                .collect();
+            workers
+                .into_iter()
+                .map(|worker| worker.join().unwrap_or_else(|e| panic::resume_unwind(e)))
+                .collect()
+        })
+    }
+}
+
 impl Drop for Table<'_> {
     fn drop(&mut self) {
         unsafe {
@@ -164,3 +335,132 @@ impl Drop for Table<'_> {
         }
     }
 }
+
+// Safety:
+//  a table only shares the read-only catalog and file IO handle with other tables,
+//  and records, columns and cursors borrow the table so cannot outlive a move.
+//  The lock of the file IO handle is compiled out of the vendored libbfio
+//  (HAVE_LOCAL_LIBBFIO), so reading tables on different threads is only safe on the
+//  read_at_offset fast path, which requires HAVE_PREAD or WINAPI (or a memory mapped
+//  file), a handle that is not opened on demand and no tracking of the offsets read,
+//  see the Safety comment of EseDb
+unsafe impl Send for Table<'_> {}
+
+/// A range of consecutive leaf pages of a [`Table`], created with [`Table::partitions`].
+/// Each partition has its own instance of the table, and can be sent to another thread
+/// (or thread pool) to read its records.
+pub struct TablePartition<'a> {
+    table: Table<'a>,
+    first_leaf_page: u32,
+    last_leaf_page: u32,
+}
+
+impl TablePartition<'_> {
+    /// Create an iterator over the records (rows) in the partition, in leaf page order.
+    /// The [`RecordCursor`] iterator and the returned [`Record`]s
+    /// are bound to the lifetime of the partition.
+    pub fn iter_records(&self) -> io::Result<RecordCursor> {
+        RecordCursor::load_range(self.table.ptr, self.first_leaf_page, self.last_leaf_page)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use crate::error::ese_result;
+    use crate::record::tests::CORRUPT_RECORD_EDB;
+    use crate::{EseDb, RecordCursor, Value};
+    use libesedb_sys::*;
+    use std::io;
+    use std::thread;
+
+    /// The values of the records, with `None` for the error that ends the cursor.
+    fn values(records: RecordCursor) -> Vec<Option<Vec<Value>>> {
+        records
+            .map(|record| {
+                let record = record.ok()?;
+                Some(record.iter_values().unwrap().map(Result::unwrap).collect())
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_partitions_cover_records() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let expected = values(table.iter_records()?);
+        assert_eq!(expected.len(), 41);
+        assert_eq!(expected[40], None);
+
+        let mut leaf_pages = 0;
+        ese_result!(
+            libesedb_table_get_number_of_leaf_pages,
+            table.ptr,
+            &mut leaf_pages
+        )?;
+        let leaf_pages = leaf_pages as usize;
+        for n in [0, 1, 2, leaf_pages, leaf_pages + 1, 64] {
+            let partitions = table.partitions(n)?;
+            assert_eq!(partitions.len(), n.clamp(1, leaf_pages));
+            let records: Vec<_> = partitions
+                .iter()
+                .flat_map(|partition| values(partition.iter_records().unwrap()))
+                .collect();
+            assert_eq!(records, expected, "{n} partitions");
+        }
+        assert!(table.par_for_each_record(4, |_| Ok(())).is_err());
+        Ok(())
+    }
+
+    #[test]
+    fn test_read_cloned_tables_on_threads() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let expected = values(table.iter_records()?);
+        let tables = [table.try_clone()?, table.try_clone()?];
+        thread::scope(|scope| {
+            let readers: Vec<_> = tables
+                .into_iter()
+                .map(|table| scope.spawn(move || values(table.iter_records().unwrap())))
+                .collect();
+            for reader in readers {
+                assert_eq!(reader.join().unwrap(), expected);
+            }
+        });
+        Ok(())
+    }
+
+    #[test]
+    fn test_projected_values() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let expected = values(table.iter_records()?);
+        for (columns, entries) in [
+            (&["Value"][..], &[1][..]),
+            (&["Note", "Id"], &[4, 0]),
+            (&["Blob", "Name", "Value"], &[3, 2, 1]),
+        ] {
+            let projected = values(table.iter_records_projected(columns)?);
+            assert_eq!(projected.len(), expected.len());
+            for (record, expected) in projected.iter().zip(&expected) {
+                let expected = expected
+                    .as_ref()
+                    .map(|values| entries.iter().map(|&entry| values[entry].clone()).collect());
+                assert_eq!(record, &expected, "{columns:?}");
+            }
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_projected_unknown_column() -> io::Result<()> {
+        let db = EseDb::open(CORRUPT_RECORD_EDB)?;
+        let table = db.table_by_name("Items")?;
+        let error = table
+            .iter_records_projected(&["Id", "Missing"])
+            .err()
+            .unwrap();
+        assert_eq!(error.kind(), io::ErrorKind::Other);
+        assert_eq!(error.to_string(), "Can't find column 'Missing'");
+        Ok(())
+    }
+}
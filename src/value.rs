@@ -324,32 +324,34 @@ impl Value {
             c @ (Self::Text(_) | Self::LargeText(_)) => {
                 let mut size = 0;
                 match ese_result!(
-                    libesedb_record_get_value_utf8_string_size,
+                    libesedb_record_get_value_utf8_string_maximum_size,
                     record_handle,
                     entry,
                     &mut size
                 )? {
-                    1 => {
-                        let mut data = vec![0; size as _];
-                        match ese_result!(
-                            libesedb_record_get_value_utf8_string,
+                    1 => match read_utf8_string(size, |data, index| {
+                        ese_result!(
+                            libesedb_record_get_value_utf8_string_with_index,
                             record_handle,
                             entry,
-                            data.as_mut_ptr(),
-                            size
-                        )? {
-                            1 => {
-                                data.pop(); // remove null byte
-                                let text = String::from_utf8_lossy(&data).into();
-                                match c {
-                                    Self::Text(_) => Self::Text(text),
-                                    Self::LargeText(_) => Self::LargeText(text),
-                                    _ => unreachable!(),
-                                }
+                            data,
+                            size,
+                            index
+                        )
+                    })? {
+                        Some(data) => {
+                            let text = match String::from_utf8(data) {
+                                Ok(text) => text,
+                                Err(e) => String::from_utf8_lossy(e.as_bytes()).into(),
+                            };
+                            match c {
+                                Self::Text(_) => Self::Text(text),
+                                Self::LargeText(_) => Self::LargeText(text),
+                                _ => unreachable!(),
                             }
-                            _ => Self::Null(()),
                         }
-                    }
+                        None => Self::Null(()),
+                    },
                     _ => Self::Null(()),
                 }
             }
@@ -456,6 +458,30 @@ impl ToString for Value {
     }
 }
 
+/// Reads a UTF-8 string into a buffer of the maximum size of the string, which `read` fills
+/// and advances the index past the end of string character of. Returns `None` if `read`
+/// returns 0 for a NULL value.
+///
+/// The maximum size does not require decompressing the data, so compressed data is
+/// decompressed and converted only once. Shrinking the buffer reallocates it, so
+/// that is only done when it leaves more than 1 KiB unused.
+pub(crate) fn read_utf8_string(
+    size: usize,
+    read: impl FnOnce(*mut u8, &mut usize) -> io::Result<i32>,
+) -> io::Result<Option<Vec<u8>>> {
+    let mut data = Vec::with_capacity(size);
+    let mut index = 0;
+    if read(data.as_mut_ptr(), &mut index)? != 1 {
+        return Ok(None);
+    }
+    // remove nul byte
+    unsafe { data.set_len(index.saturating_sub(1).min(size)) };
+    if data.capacity() - data.len() > 1024 {
+        data.shrink_to_fit();
+    }
+    Ok(Some(data))
+}
+
 const FILETIME_EPOCH: OffsetDateTime = datetime!(1601-01-01 00:00:00 +0);
 const OLETIME_EPOCH: OffsetDateTime = datetime!(1899-12-30 00:00:00 +0);
 